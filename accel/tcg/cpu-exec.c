@@ -238,6 +238,77 @@ static TranslationBlock *tb_htable_lookup(CPUState *cpu, vaddr pc,
     return qht_lookup_custom(&tb_ctx.htable, &desc, h, tb_lookup_cmp);
 }
 
+/*
+ * Move the TB in slot @hash of @jc into victim entry @i, ahead of
+ * overwriting the slot.  Called only by the vCPU owning @jc.
+ */
+static void tb_jmp_cache_evict(CPUJumpCache *jc, uint32_t hash, unsigned i)
+{
+    jc->victim[i].pc = jc->array[hash].pc;
+    /* Ensure pc is written first. */
+    qatomic_store_release(&jc->victim[i].tb,
+                          qatomic_read(&jc->array[hash].tb));
+}
+
+/*
+ * Probe the victim entries of @jc.  On a hit the displaced TB of slot
+ * @hash takes the place of the hit, and the caller refills the slot.
+ */
+static TranslationBlock *tb_jmp_victim_lookup(CPUJumpCache *jc, uint32_t hash,
+                                              vaddr pc, uint64_t cs_base,
+                                              uint32_t flags, uint32_t cflags)
+{
+    for (unsigned i = 0; i < TB_JMP_VICTIM_SIZE; i++) {
+        TranslationBlock *tb;
+
+        if (cflags & CF_PCREL) {
+            tb = qatomic_load_acquire(&jc->victim[i].tb);
+            if (!tb || jc->victim[i].pc != pc) {
+                continue;
+            }
+        } else {
+            tb = qatomic_rcu_read(&jc->victim[i].tb);
+            if (!tb || tb->pc != pc) {
+                continue;
+            }
+        }
+        if (tb->cs_base == cs_base &&
+            tb->flags == flags &&
+            tb_cflags(tb) == cflags) {
+            tb_jmp_cache_evict(jc, hash, i);
+            return tb;
+        }
+    }
+    return NULL;
+}
+
+static void tb_jmp_cache_set(CPUJumpCache *jc, uint32_t hash, vaddr pc,
+                             TranslationBlock *tb, uint32_t cflags)
+{
+    if (cflags & CF_PCREL) {
+        jc->array[hash].pc = pc;
+        /* Ensure pc is written first. */
+        qatomic_store_release(&jc->array[hash].tb, tb);
+    } else {
+        /* Use the pc value already stored in tb->pc. */
+        qatomic_set(&jc->array[hash].tb, tb);
+    }
+}
+
+/*
+ * Install @tb for @pc in slot @hash of @jc, keeping the previous
+ * occupant of the slot as a victim entry.
+ */
+static void tb_jmp_cache_insert(CPUJumpCache *jc, uint32_t hash, vaddr pc,
+                                TranslationBlock *tb, uint32_t cflags)
+{
+    if (qatomic_read(&jc->array[hash].tb)) {
+        tb_jmp_cache_evict(jc, hash,
+                           jc->victim_next++ % TB_JMP_VICTIM_SIZE);
+    }
+    tb_jmp_cache_set(jc, hash, pc, tb, cflags);
+}
+
 /* Might cause an exception, so have a longjmp destination ready */
 static inline TranslationBlock *tb_lookup(CPUState *cpu, vaddr pc,
                                           uint64_t cs_base, uint32_t flags,
@@ -264,13 +335,6 @@ static inline TranslationBlock *tb_lookup(CPUState *cpu, vaddr pc,
                    tb_cflags(tb) == cflags)) {
             return tb;
         }
-        tb = tb_htable_lookup(cpu, pc, cs_base, flags, cflags);
-        if (tb == NULL) {
-            return NULL;
-        }
-        jc->array[hash].pc = pc;
-        /* Ensure pc is written first. */
-        qatomic_store_release(&jc->array[hash].tb, tb);
     } else {
         /* Use rcu_read to ensure current load of pc from *tb. */
         tb = qatomic_rcu_read(&jc->array[hash].tb);
@@ -282,14 +346,20 @@ static inline TranslationBlock *tb_lookup(CPUState *cpu, vaddr pc,
                    tb_cflags(tb) == cflags)) {
             return tb;
         }
-        tb = tb_htable_lookup(cpu, pc, cs_base, flags, cflags);
-        if (tb == NULL) {
-            return NULL;
-        }
-        /* Use the pc value already stored in tb->pc. */
-        qatomic_set(&jc->array[hash].tb, tb);
     }
 
+    tb = tb_jmp_victim_lookup(jc, hash, pc, cs_base, flags, cflags);
+    if (tb) {
+        /* The slot's previous TB already took the victim entry. */
+        tb_jmp_cache_set(jc, hash, pc, tb, cflags);
+        return tb;
+    }
+
+    tb = tb_htable_lookup(cpu, pc, cs_base, flags, cflags);
+    if (tb == NULL) {
+        return NULL;
+    }
+    tb_jmp_cache_insert(jc, hash, pc, tb, cflags);
     return tb;
 }
 
@@ -924,6 +994,12 @@ static inline void cpu_loop_exec_tb(CPUState *cpu, TranslationBlock *tb,
     }
 
     *last_tb = NULL;
+#ifndef CONFIG_USER_ONLY
+    if (unlikely(qatomic_read(&cpu->tb_sample_request))) {
+        qatomic_set(&cpu->tb_sample_request, false);
+        tb_sample_record(log_pc(cpu, tb));
+    }
+#endif
     insns_left = qatomic_read(&cpu->neg.icount_decr.u32);
     if (insns_left < 0) {
         /* Something asked us to stop executing chained TBs; just
@@ -999,9 +1075,6 @@ cpu_exec_loop(CPUState *cpu, SyncClocks *sc)
 
             tb = tb_lookup(cpu, pc, cs_base, flags, cflags);
             if (tb == NULL) {
-                CPUJumpCache *jc;
-                uint32_t h;
-
                 mmap_lock();
                 tb = tb_gen_code(cpu, pc, cs_base, flags, cflags);
                 mmap_unlock();
@@ -1010,16 +1083,9 @@ cpu_exec_loop(CPUState *cpu, SyncClocks *sc)
                  * We add the TB in the virtual pc hash table
                  * for the fast lookup
                  */
-                h = tb_jmp_cache_hash_func(pc);
-                jc = cpu->tb_jmp_cache;
-                if (cflags & CF_PCREL) {
-                    jc->array[h].pc = pc;
-                    /* Ensure pc is written first. */
-                    qatomic_store_release(&jc->array[h].tb, tb);
-                } else {
-                    /* Use the pc value already stored in tb->pc. */
-                    qatomic_set(&jc->array[h].tb, tb);
-                }
+                tb_jmp_cache_insert(cpu->tb_jmp_cache,
+                                    tb_jmp_cache_hash_func(pc),
+                                    pc, tb, cflags);
             }
 
 #ifndef CONFIG_USER_ONLY
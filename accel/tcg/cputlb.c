@@ -115,6 +115,10 @@ static void tb_jmp_cache_clear_page(CPUState *cpu, vaddr page_addr)
     for (i = 0; i < TB_JMP_PAGE_SIZE; i++) {
         qatomic_set(&jc->array[i0 + i].tb, NULL);
     }
+    /* Victim entries are not sorted by page; just drop them all. */
+    for (i = 0; i < TB_JMP_VICTIM_SIZE; i++) {
+        qatomic_set(&jc->victim[i].tb, NULL);
+    }
 }
 
 /**
@@ -237,7 +241,7 @@ static void tlb_mmu_flush_locked(CPUTLBDesc *desc, CPUTLBDescFast *fast)
     desc->n_used_entries = 0;
     desc->large_page_addr = -1;
     desc->large_page_mask = -1;
-    desc->vindex = 0;
+    memset(desc->vindex, 0, sizeof(desc->vindex));
     memset(fast->table, -1, sizeof_tlb(fast));
     memset(desc->vtable, -1, sizeof(desc->vtable));
 }
@@ -451,16 +455,80 @@ static inline bool tlb_flush_entry_locked(CPUTLBEntry *tlb_entry, vaddr page)
     return tlb_flush_entry_mask_locked(tlb_entry, page, -1);
 }
 
+/*
+ * Called with tlb_c.lock held.
+ * Called only from the vCPU context, i.e. the TLB's owner thread.
+ */
+static inline void copy_tlb_helper_locked(CPUTLBEntry *d, const CPUTLBEntry *s)
+{
+    *d = *s;
+}
+
+/*
+ * Return the first victim tlb index of the set for @page.  Pages that
+ * conflict in the main table share the low bits of their page number,
+ * so hash all of the bits to spread them over different sets.
+ */
+static inline size_t vtlb_set(vaddr page)
+{
+    uint64_t h = (page >> TARGET_PAGE_BITS) * 0x9e3779b97f4a7c15ull;
+
+    return (h >> (64 - CPU_VTLB_SET_BITS)) * CPU_VTLB_WAYS;
+}
+
+/* Return the page mapped by the non-empty @te. */
+static vaddr tlb_entry_page(const CPUTLBEntry *te)
+{
+    uint64_t addr = tlb_read_idx(te, MMU_DATA_LOAD);
+
+    if (addr == -1) {
+        addr = tlb_read_idx(te, MMU_DATA_STORE);
+    }
+    if (addr == -1) {
+        addr = tlb_read_idx(te, MMU_INST_FETCH);
+    }
+    return addr & TARGET_PAGE_MASK;
+}
+
+/*
+ * Called with tlb_c.lock held.
+ * Fill an empty way of the set if there is one, else replace round-robin.
+ */
+static void tlb_vtlb_insert_locked(CPUTLBDesc *desc, const CPUTLBEntry *te,
+                                   const CPUTLBEntryFull *full)
+{
+    size_t set = vtlb_set(tlb_entry_page(te));
+    size_t vidx;
+
+    for (vidx = set; vidx < set + CPU_VTLB_WAYS; vidx++) {
+        if (tlb_entry_is_empty(&desc->vtable[vidx])) {
+            break;
+        }
+    }
+    if (vidx == set + CPU_VTLB_WAYS) {
+        vidx = set + desc->vindex[set / CPU_VTLB_WAYS]++ % CPU_VTLB_WAYS;
+    }
+
+    copy_tlb_helper_locked(&desc->vtable[vidx], te);
+    desc->vfulltlb[vidx] = *full;
+}
+
 /* Called with tlb_c.lock held */
 static void tlb_flush_vtlb_page_mask_locked(CPUState *cpu, int mmu_idx,
                                             vaddr page,
                                             vaddr mask)
 {
     CPUTLBDesc *d = &cpu->neg.tlb.d[mmu_idx];
-    int k;
+    size_t k, start = 0, end = CPU_VTLB_SIZE;
 
     assert_cpu_is_self(cpu);
-    for (k = 0; k < CPU_VTLB_SIZE; k++) {
+
+    /* A single page can only be cached in its own set. */
+    if (mask == -1) {
+        start = vtlb_set(page);
+        end = start + CPU_VTLB_WAYS;
+    }
+    for (k = start; k < end; k++) {
         if (tlb_flush_entry_mask_locked(&d->vtable[k], page, mask)) {
             tlb_n_used_entries_dec(cpu, mmu_idx);
         }
@@ -992,15 +1060,6 @@ static void tlb_reset_dirty_range_locked(CPUTLBEntry *tlb_entry,
     }
 }
 
-/*
- * Called with tlb_c.lock held.
- * Called only from the vCPU context, i.e. the TLB's owner thread.
- */
-static inline void copy_tlb_helper_locked(CPUTLBEntry *d, const CPUTLBEntry *s)
-{
-    *d = *s;
-}
-
 /* This is a cross vCPU call (i.e. another vCPU resetting the flags of
  * the target vCPU).
  * We must take tlb_c.lock to avoid racing with another vCPU update. The only
@@ -1220,12 +1279,8 @@ void tlb_set_page_full(CPUState *cpu, int mmu_idx,
      * different page; otherwise just overwrite the stale data.
      */
     if (!tlb_hit_page_anyprot(te, addr_page) && !tlb_entry_is_empty(te)) {
-        unsigned vidx = desc->vindex++ % CPU_VTLB_SIZE;
-        CPUTLBEntry *tv = &desc->vtable[vidx];
-
         /* Evict the old entry into the victim tlb.  */
-        copy_tlb_helper_locked(tv, te);
-        desc->vfulltlb[vidx] = desc->fulltlb[index];
+        tlb_vtlb_insert_locked(desc, te, &desc->fulltlb[index]);
         tlb_n_used_entries_dec(cpu, mmu_idx);
     }
 
@@ -1362,27 +1417,31 @@ static void io_failed(CPUState *cpu, CPUTLBEntryFull *full, vaddr addr,
 static bool victim_tlb_hit(CPUState *cpu, size_t mmu_idx, size_t index,
                            MMUAccessType access_type, vaddr page)
 {
-    size_t vidx;
+    CPUTLBDesc *desc = &cpu->neg.tlb.d[mmu_idx];
+    size_t vidx, set = vtlb_set(page);
 
     assert_cpu_is_self(cpu);
-    for (vidx = 0; vidx < CPU_VTLB_SIZE; ++vidx) {
-        CPUTLBEntry *vtlb = &cpu->neg.tlb.d[mmu_idx].vtable[vidx];
+    for (vidx = set; vidx < set + CPU_VTLB_WAYS; ++vidx) {
+        CPUTLBEntry *vtlb = &desc->vtable[vidx];
         uint64_t cmp = tlb_read_idx(vtlb, access_type);
 
         if (cmp == page) {
-            /* Found entry in victim tlb, swap tlb and iotlb.  */
+            /*
+             * Found entry in victim tlb, exchange it with the tlb entry.
+             * The evicted entry belongs to the set of its own page.
+             */
             CPUTLBEntry tmptlb, *tlb = &cpu->neg.tlb.f[mmu_idx].table[index];
+            CPUTLBEntryFull tmpf = desc->fulltlb[index];
 
             qemu_spin_lock(&cpu->neg.tlb.c.lock);
             copy_tlb_helper_locked(&tmptlb, tlb);
             copy_tlb_helper_locked(tlb, vtlb);
-            copy_tlb_helper_locked(vtlb, &tmptlb);
+            desc->fulltlb[index] = desc->vfulltlb[vidx];
+            memset(vtlb, -1, sizeof(*vtlb));
+            if (!tlb_entry_is_empty(&tmptlb)) {
+                tlb_vtlb_insert_locked(desc, &tmptlb, &tmpf);
+            }
             qemu_spin_unlock(&cpu->neg.tlb.c.lock);
-
-            CPUTLBEntryFull *f1 = &cpu->neg.tlb.d[mmu_idx].fulltlb[index];
-            CPUTLBEntryFull *f2 = &cpu->neg.tlb.d[mmu_idx].vfulltlb[vidx];
-            CPUTLBEntryFull tmpf;
-            tmpf = *f1; *f1 = *f2; *f2 = tmpf;
             return true;
         }
     }
@@ -14,6 +14,9 @@
 extern int64_t max_delay;
 extern int64_t max_advance;
 
+void tb_sample_start(unsigned hz);
+void tb_sample_record(vaddr pc);
+
 /*
  * Return true if CS is not running in parallel with other cpus, either
  * because there are no other cpus or we are within an exclusive context.
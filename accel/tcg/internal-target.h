@@ -43,9 +43,10 @@ void page_table_config_init(void);
  * account for other TBs on the same page, defer undoing any page protection
  * until we receive the write fault.
  */
-static inline void tb_lock_page0(tb_page_addr_t p0)
+static inline bool tb_lock_page0(tb_page_addr_t p0)
 {
     page_protect(p0);
+    return false;
 }
 
 static inline void tb_lock_page1(tb_page_addr_t p0, tb_page_addr_t p1)
@@ -56,7 +57,7 @@ static inline void tb_lock_page1(tb_page_addr_t p0, tb_page_addr_t p1)
 static inline void tb_unlock_page1(tb_page_addr_t p0, tb_page_addr_t p1) { }
 static inline void tb_unlock_pages(TranslationBlock *tb) { }
 #else
-void tb_lock_page0(tb_page_addr_t);
+bool tb_lock_page0(tb_page_addr_t);
 void tb_lock_page1(tb_page_addr_t, tb_page_addr_t);
 void tb_unlock_page1(tb_page_addr_t, tb_page_addr_t);
 void tb_unlock_pages(TranslationBlock *);
@@ -9,10 +9,13 @@
 #include "qemu/osdep.h"
 #include "qemu/accel.h"
 #include "qemu/qht.h"
+#include "qemu/stats64.h"
+#include "qemu/timer.h"
 #include "qapi/error.h"
 #include "qapi/type-helpers.h"
 #include "qapi/qapi-commands-machine.h"
 #include "monitor/monitor.h"
+#include "disas/disas.h"
 #include "sysemu/cpus.h"
 #include "sysemu/cpu-timers.h"
 #include "sysemu/tcg.h"
@@ -91,6 +94,8 @@ static void print_qht_statistics(struct qht_stats hst, GString *buf)
                            "Histogram: %s\n",
                            qdist_avg(&hst.chain), hgram);
     g_free(hgram);
+
+    g_string_append_printf(buf, "TB hash resizes     %zu\n", hst.resizes);
 }
 
 struct tb_tree_stats {
@@ -191,6 +196,8 @@ static void dump_exec_info(GString *buf)
                            qatomic_read(&tb_ctx.tb_flush_count));
     g_string_append_printf(buf, "TB invalidate count %u\n",
                            qatomic_read(&tb_ctx.tb_phys_invalidate_count));
+    g_string_append_printf(buf, "TB SMC invalidations %u\n",
+                           qatomic_read(&tb_ctx.tb_smc_invalidate_count));
 
     tlb_flush_counts(&flush_full, &flush_part, &flush_elide);
     g_string_append_printf(buf, "TLB full flushes    %zu\n", flush_full);
@@ -235,10 +242,156 @@ HumanReadableText *qmp_x_query_opcount(Error **errp)
     return human_readable_text_from_str(buf);
 }
 
+/*
+ * Translation block sampling.  A timer periodically asks each running
+ * vCPU to leave the chained TBs; the vCPU then records the guest pc of
+ * the TB it was about to enter.  The most recent samples are kept in a
+ * lock-free ring, which is only aggregated when the profile is read.
+ */
+
+#define TB_SAMPLE_RING_BITS 16
+#define TB_SAMPLE_RING_SIZE (1u << TB_SAMPLE_RING_BITS)
+#define TB_SAMPLE_TOP_N     20
+
+static struct {
+    QEMUTimer *timer;
+    unsigned hz;
+    int64_t period_ns;
+    Stat64 total;
+    Stat64 idle;
+    /* Next ring slot; free to wrap, as the ring size divides 2^32. */
+    unsigned next;
+    /* Set once every slot of the ring has been written. */
+    bool full;
+    uint64_t ring[TB_SAMPLE_RING_SIZE];
+} tb_sample;
+
+typedef struct TBSampleEntry {
+    vaddr pc;
+    unsigned count;
+} TBSampleEntry;
+
+void tb_sample_record(vaddr pc)
+{
+    unsigned idx = qatomic_fetch_inc(&tb_sample.next);
+
+    stat64_add(&tb_sample.total, 1);
+    qatomic_set_u64(&tb_sample.ring[idx & (TB_SAMPLE_RING_SIZE - 1)], pc);
+    if (unlikely(idx == TB_SAMPLE_RING_SIZE - 1)) {
+        qatomic_set(&tb_sample.full, true);
+    }
+}
+
+static void tb_sample_tick(void *opaque)
+{
+    CPUState *cpu;
+
+    CPU_FOREACH(cpu) {
+        if (cpu_is_stopped(cpu)) {
+            continue;
+        }
+        if (qatomic_read(&cpu->halted)) {
+            stat64_add(&tb_sample.idle, 1);
+            continue;
+        }
+        /* As for cpu_exit, but without leaving cpu_exec. */
+        qatomic_set(&cpu->tb_sample_request, true);
+        smp_wmb();
+        qatomic_set(&cpu->neg.icount_decr.u16.high, -1);
+    }
+    timer_mod(tb_sample.timer,
+              qemu_clock_get_ns(QEMU_CLOCK_REALTIME) + tb_sample.period_ns);
+}
+
+void tb_sample_start(unsigned hz)
+{
+    tb_sample.hz = hz;
+    tb_sample.period_ns = NANOSECONDS_PER_SECOND / hz;
+    tb_sample.timer = timer_new_ns(QEMU_CLOCK_REALTIME, tb_sample_tick, NULL);
+    timer_mod(tb_sample.timer,
+              qemu_clock_get_ns(QEMU_CLOCK_REALTIME) + tb_sample.period_ns);
+}
+
+static int tb_sample_pc_cmp(const void *a, const void *b)
+{
+    vaddr pa = *(const vaddr *)a;
+    vaddr pb = *(const vaddr *)b;
+
+    return pa < pb ? -1 : pa > pb;
+}
+
+static gint tb_sample_count_cmp(gconstpointer a, gconstpointer b)
+{
+    const TBSampleEntry *ea = a;
+    const TBSampleEntry *eb = b;
+
+    return ea->count < eb->count ? 1 : -(ea->count > eb->count);
+}
+
+static void dump_tb_samples(GString *buf)
+{
+    unsigned n = qatomic_read(&tb_sample.full) ? TB_SAMPLE_RING_SIZE
+                 : MIN(qatomic_read(&tb_sample.next), TB_SAMPLE_RING_SIZE);
+    g_autofree vaddr *pcs = g_new(vaddr, n);
+    g_autoptr(GArray) hot = g_array_new(false, false, sizeof(TBSampleEntry));
+    unsigned i, j;
+
+    g_string_append_printf(buf, "TB samples          %" PRIu64 " at %u Hz "
+                           "(%" PRIu64 " idle)\n",
+                           stat64_get(&tb_sample.total), tb_sample.hz,
+                           stat64_get(&tb_sample.idle));
+    if (n == 0) {
+        return;
+    }
+
+    for (i = 0; i < n; i++) {
+        pcs[i] = qatomic_read_u64(&tb_sample.ring[i]);
+    }
+    qsort(pcs, n, sizeof(vaddr), tb_sample_pc_cmp);
+    for (i = 0; i < n; i = j) {
+        TBSampleEntry e = { .pc = pcs[i] };
+
+        for (j = i; j < n && pcs[j] == pcs[i]; j++) {
+            e.count++;
+        }
+        g_array_append_val(hot, e);
+    }
+    g_array_sort(hot, tb_sample_count_cmp);
+
+    g_string_append_printf(buf, "Hottest TBs of the last %u samples:\n", n);
+    for (i = 0; i < MIN(hot->len, TB_SAMPLE_TOP_N); i++) {
+        TBSampleEntry *e = &g_array_index(hot, TBSampleEntry, i);
+
+        g_string_append_printf(buf, "%6.2f%% %8u  0x%016" VADDR_PRIx "  %s\n",
+                               (double)e->count * 100 / n, e->count,
+                               e->pc, lookup_symbol(e->pc));
+    }
+}
+
+HumanReadableText *qmp_x_query_jit_profile(Error **errp)
+{
+    g_autoptr(GString) buf = g_string_new("");
+
+    if (!tcg_enabled()) {
+        error_setg(errp, "JIT profile is only available with accel=tcg");
+        return NULL;
+    }
+    if (!tb_sample.timer) {
+        error_setg(errp, "TB sampling is disabled; "
+                   "enable it with -accel tcg,profile-hz=N");
+        return NULL;
+    }
+
+    dump_tb_samples(buf);
+
+    return human_readable_text_from_str(buf);
+}
+
 static void hmp_tcg_register(void)
 {
     monitor_register_hmp_info_hrt("jit", qmp_x_query_jit);
     monitor_register_hmp_info_hrt("opcount", qmp_x_query_opcount);
+    monitor_register_hmp_info_hrt("jit-profile", qmp_x_query_jit_profile);
 }
 
 type_init(hmp_tcg_register);
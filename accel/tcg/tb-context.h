@@ -26,6 +26,14 @@
 #define CODE_GEN_HTABLE_BITS     15
 #define CODE_GEN_HTABLE_SIZE     (1 << CODE_GEN_HTABLE_BITS)
 
+/*
+ * Translation buffer bytes per initial hash table entry.  This is well
+ * above the average TB footprint, so a full buffer still resizes a few
+ * times, but large buffers no longer start at the minimum size and
+ * double, with all bucket locks held, all the way up.
+ */
+#define CODE_GEN_HTABLE_DIV      (8 * 1024)
+
 typedef struct TBContext TBContext;
 
 struct TBContext {
@@ -35,6 +43,8 @@ struct TBContext {
     /* statistics */
     unsigned tb_flush_count;
     unsigned tb_phys_invalidate_count;
+    /* guest stores that hit a page containing translated code */
+    unsigned tb_smc_invalidate_count;
 };
 
 extern TBContext tb_ctx;
@@ -12,17 +12,29 @@
 #define TB_JMP_CACHE_BITS 12
 #define TB_JMP_CACHE_SIZE (1 << TB_JMP_CACHE_BITS)
 
+/*
+ * Fully associative victim entries, holding TBs recently displaced from
+ * their slot in the direct-mapped array.  Probed before the hash table.
+ */
+#define TB_JMP_VICTIM_SIZE 8
+
+typedef struct CPUJumpCacheEntry {
+    TranslationBlock *tb;
+    vaddr pc;
+} CPUJumpCacheEntry;
+
 /*
  * Accessed in parallel; all accesses to 'tb' must be atomic.
  * For CF_PCREL, accesses to 'pc' must be protected by a
  * load_acquire/store_release to 'tb'.
+ * Only the owning vCPU moves entries between 'array' and 'victim';
+ * other threads may only clear 'tb'.
  */
 struct CPUJumpCache {
     struct rcu_head rcu;
-    struct {
-        TranslationBlock *tb;
-        vaddr pc;
-    } array[TB_JMP_CACHE_SIZE];
+    CPUJumpCacheEntry array[TB_JMP_CACHE_SIZE];
+    CPUJumpCacheEntry victim[TB_JMP_VICTIM_SIZE];
+    unsigned victim_next;
 };
 
 #endif /* ACCEL_TCG_TB_JMP_CACHE_H */
@@ -58,8 +58,10 @@ static bool tb_cmp(const void *ap, const void *bp)
 void tb_htable_init(void)
 {
     unsigned int mode = QHT_MODE_AUTO_RESIZE;
+    size_t n_elems = MAX(CODE_GEN_HTABLE_SIZE,
+                         tcg_code_capacity() / CODE_GEN_HTABLE_DIV);
 
-    qht_init(&tb_ctx.htable, tb_cmp, CODE_GEN_HTABLE_SIZE, mode);
+    qht_init(&tb_ctx.htable, tb_cmp, n_elems, mode);
 }
 
 typedef struct PageDesc PageDesc;
@@ -397,9 +399,19 @@ static void page_unlock(PageDesc *pd)
     page_unlock__debug(pd);
 }
 
-void tb_lock_page0(tb_page_addr_t paddr)
+/*
+ * Lock the first page of a TB being translated.
+ * Return true if we had to wait for another thread holding the lock.
+ */
+bool tb_lock_page0(tb_page_addr_t paddr)
 {
-    page_lock(page_find_alloc(paddr >> TARGET_PAGE_BITS, true));
+    PageDesc *pd = page_find_alloc(paddr >> TARGET_PAGE_BITS, true);
+
+    if (!page_trylock(pd)) {
+        return false;
+    }
+    page_lock(pd);
+    return true;
 }
 
 void tb_lock_page1(tb_page_addr_t paddr0, tb_page_addr_t paddr1)
@@ -593,20 +605,41 @@ static gint tb_page_addr_cmp(gconstpointer ap, gconstpointer bp, gpointer udata)
 }
 
 /*
- * Lock a range of pages ([@start,@last]) as well as the pages of all
- * intersecting TBs.
+ * Return true if the part of @tb on its @n'th page intersects
+ * [@start, @last], which must not cross a page.
+ * NOTE: this is subtle as a TB may span two physical pages.
+ */
+static bool tb_page_intersects(TranslationBlock *tb, unsigned n,
+                               tb_page_addr_t start, tb_page_addr_t last)
+{
+    tb_page_addr_t tb_start, tb_last;
+
+    tb_start = tb_page_addr0(tb);
+    tb_last = tb_start + tb->size - 1;
+    if (n == 0) {
+        tb_last = MIN(tb_last, tb_start | ~TARGET_PAGE_MASK);
+    } else {
+        tb_start = tb_page_addr1(tb);
+        tb_last = tb_start + (tb_last & ~TARGET_PAGE_MASK);
+    }
+    return !(tb_last < start || tb_start > last);
+}
+
+/*
+ * Lock a range of pages ([@start,@last]) as well as the other page of
+ * each TB that intersects the range.
  * Locking order: acquire locks in ascending order of page index.
  */
 static struct page_collection *page_collection_lock(tb_page_addr_t start,
                                                     tb_page_addr_t last)
 {
     struct page_collection *set = g_malloc(sizeof(*set));
-    tb_page_addr_t index;
+    tb_page_addr_t index, index_first, index_last;
     PageDesc *pd;
 
-    start >>= TARGET_PAGE_BITS;
-    last >>= TARGET_PAGE_BITS;
-    g_assert(start <= last);
+    index_first = start >> TARGET_PAGE_BITS;
+    index_last = last >> TARGET_PAGE_BITS;
+    g_assert(index_first <= index_last);
 
     set->tree = q_tree_new_full(tb_page_addr_cmp, NULL, NULL,
                                 page_entry_destroy);
@@ -616,7 +649,8 @@ static struct page_collection *page_collection_lock(tb_page_addr_t start,
  retry:
     q_tree_foreach(set->tree, page_entry_lock, NULL);
 
-    for (index = start; index <= last; index++) {
+    for (index = index_first; index <= index_last; index++) {
+        tb_page_addr_t page_start, page_last;
         TranslationBlock *tb;
         PageForEachNext n;
 
@@ -629,7 +663,17 @@ static struct page_collection *page_collection_lock(tb_page_addr_t start,
             goto retry;
         }
         assert_page_locked(pd);
+        page_start = MAX(start, index << TARGET_PAGE_BITS);
+        page_last = MIN(last, (index << TARGET_PAGE_BITS) | ~TARGET_PAGE_MASK);
         PAGE_FOR_EACH_TB(unused, unused, pd, tb, n) {
+            /*
+             * Only TBs that will be invalidated need their other page
+             * locked; a small write must not serialize against every
+             * neighbouring page that merely shares a TB list with it.
+             */
+            if (!tb_page_intersects(tb, n, page_start, page_last)) {
+                continue;
+            }
             if (page_trylock_add(set, tb_page_addr0(tb)) ||
                 (tb_page_addr1(tb) != -1 &&
                  page_trylock_add(set, tb_page_addr1(tb)))) {
@@ -712,7 +756,7 @@ static void tb_record(TranslationBlock *tb)
     tb_page_addr_t paddr0 = tb_page_addr0(tb);
     tb_page_addr_t paddr1 = tb_page_addr1(tb);
     tb_page_addr_t pindex0 = paddr0 >> TARGET_PAGE_BITS;
-    tb_page_addr_t pindex1 = paddr0 >> TARGET_PAGE_BITS;
+    tb_page_addr_t pindex1 = paddr1 >> TARGET_PAGE_BITS;
 
     assert(paddr0 != -1);
     if (unlikely(paddr1 != -1) && pindex0 != pindex1) {
@@ -744,7 +788,7 @@ static void tb_remove(TranslationBlock *tb)
     tb_page_addr_t paddr0 = tb_page_addr0(tb);
     tb_page_addr_t paddr1 = tb_page_addr1(tb);
     tb_page_addr_t pindex0 = paddr0 >> TARGET_PAGE_BITS;
-    tb_page_addr_t pindex1 = paddr0 >> TARGET_PAGE_BITS;
+    tb_page_addr_t pindex1 = paddr1 >> TARGET_PAGE_BITS;
 
     assert(paddr0 != -1);
     if (unlikely(paddr1 != -1) && pindex0 != pindex1) {
@@ -770,7 +814,12 @@ static void do_tb_flush(CPUState *cpu, run_on_cpu_data tb_flush_count)
         tcg_flush_jmp_cache(cpu);
     }
 
-    qht_reset_size(&tb_ctx.htable, CODE_GEN_HTABLE_SIZE);
+    /*
+     * Keep the hash table at its current size: the guest will most likely
+     * translate as much code again, and growing the table back step by
+     * step rehashes every entry under the table lock each time.
+     */
+    qht_reset(&tb_ctx.htable);
     tb_remove_all();
 
     tcg_region_reset_all();
@@ -892,6 +941,11 @@ static void tb_jmp_cache_inval_tb(TranslationBlock *tb)
             if (qatomic_read(&jc->array[h].tb) == tb) {
                 qatomic_set(&jc->array[h].tb, NULL);
             }
+            for (int i = 0; i < TB_JMP_VICTIM_SIZE; i++) {
+                if (qatomic_read(&jc->victim[i].tb) == tb) {
+                    qatomic_set(&jc->victim[i].tb, NULL);
+                }
+            }
         }
     }
 }
@@ -1052,6 +1106,7 @@ bool tb_invalidate_phys_page_unwind(tb_page_addr_t addr, uintptr_t pc)
 #ifndef TARGET_HAS_PRECISE_SMC
     pc = 0;
 #endif
+    qatomic_inc(&tb_ctx.tb_smc_invalidate_count);
     if (!pc) {
         tb_invalidate_phys_page(addr);
         return false;
@@ -1114,18 +1169,7 @@ tb_invalidate_phys_page_range__locked(struct page_collection *pages,
      * XXX: see if in some cases it could be faster to invalidate all the code
      */
     PAGE_FOR_EACH_TB(start, last, p, tb, n) {
-        tb_page_addr_t tb_start, tb_last;
-
-        /* NOTE: this is subtle as a TB may span two physical pages */
-        tb_start = tb_page_addr0(tb);
-        tb_last = tb_start + tb->size - 1;
-        if (n == 0) {
-            tb_last = MIN(tb_last, tb_start | ~TARGET_PAGE_MASK);
-        } else {
-            tb_start = tb_page_addr1(tb);
-            tb_last = tb_start + (tb_last & ~TARGET_PAGE_MASK);
-        }
-        if (!(tb_last < start || tb_start > last)) {
+        if (tb_page_intersects(tb, n, start, last)) {
 #ifdef TARGET_HAS_PRECISE_SMC
             if (current_tb == tb &&
                 (tb_cflags(current_tb) & CF_COUNT_MASK) != 1) {
@@ -1205,8 +1249,10 @@ void tb_invalidate_phys_range(tb_page_addr_t start, tb_page_addr_t last)
             continue;
         }
         assert_page_locked(pd);
+        /* Must match the range page_collection_lock() locked for. */
         page_start = index << TARGET_PAGE_BITS;
         page_last = page_start | ~TARGET_PAGE_MASK;
+        page_start = MAX(page_start, start);
         page_last = MIN(page_last, last);
         tb_invalidate_phys_page_range__locked(pages, pd,
                                               page_start, page_last, 0);
@@ -1243,6 +1289,7 @@ void tb_invalidate_phys_range_fast(ram_addr_t ram_addr,
 {
     struct page_collection *pages;
 
+    qatomic_inc(&tb_ctx.tb_smc_invalidate_count);
     pages = page_collection_lock(ram_addr, ram_addr + size - 1);
     tb_invalidate_phys_page_fast__locked(pages, ram_addr, size, retaddr);
     page_collection_unlock(pages);
@@ -47,6 +47,7 @@ struct TCGState {
     bool one_insn_per_tb;
     int splitwx_enabled;
     unsigned long tb_size;
+    uint32_t profile_hz;
 };
 typedef struct TCGState TCGState;
 
@@ -113,8 +114,9 @@ static int tcg_init_machine(MachineState *ms)
     mttcg_enabled = s->mttcg_enabled;
 
     page_init();
-    tb_htable_init();
     tcg_init(s->tb_size * MiB, s->splitwx_enabled, max_cpus);
+    /* Sized from the translation buffer, so after tcg_init. */
+    tb_htable_init();
 
 #if defined(CONFIG_SOFTMMU)
     /*
@@ -123,6 +125,11 @@ static int tcg_init_machine(MachineState *ms)
      */
     tcg_prologue_init();
 #endif
+#ifndef CONFIG_USER_ONLY
+    if (s->profile_hz) {
+        tb_sample_start(s->profile_hz);
+    }
+#endif
 
     return 0;
 }
@@ -181,6 +188,34 @@ static void tcg_set_tb_size(Object *obj, Visitor *v,
     s->tb_size = value;
 }
 
+static void tcg_get_profile_hz(Object *obj, Visitor *v,
+                               const char *name, void *opaque,
+                               Error **errp)
+{
+    TCGState *s = TCG_STATE(obj);
+    uint32_t value = s->profile_hz;
+
+    visit_type_uint32(v, name, &value, errp);
+}
+
+static void tcg_set_profile_hz(Object *obj, Visitor *v,
+                               const char *name, void *opaque,
+                               Error **errp)
+{
+    TCGState *s = TCG_STATE(obj);
+    uint32_t value;
+
+    if (!visit_type_uint32(v, name, &value, errp)) {
+        return;
+    }
+    if (value > 10000) {
+        error_setg(errp, "profile-hz must be at most 10000");
+        return;
+    }
+
+    s->profile_hz = value;
+}
+
 static bool tcg_get_splitwx(Object *obj, Error **errp)
 {
     TCGState *s = TCG_STATE(obj);
@@ -242,6 +277,12 @@ static void tcg_accel_class_init(ObjectClass *oc, void *data)
     object_class_property_set_description(oc, "tb-size",
         "TCG translation block cache size");
 
+    object_class_property_add(oc, "profile-hz", "int",
+        tcg_get_profile_hz, tcg_set_profile_hz,
+        NULL, NULL);
+    object_class_property_set_description(oc, "profile-hz",
+        "Sample executing translation blocks at this rate");
+
     object_class_property_add_bool(oc, "split-wx",
         tcg_get_splitwx, tcg_set_splitwx);
     object_class_property_set_description(oc, "split-wx",
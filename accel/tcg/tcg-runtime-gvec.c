@@ -1068,9 +1068,8 @@ DO_CMP2(64)
 #undef DO_CMP1
 #undef DO_CMP2
 
-void HELPER(gvec_ssadd8)(void *d, void *a, void *b, uint32_t desc)
+static void gvec_ssadd8_int(void *d, void *a, void *b, intptr_t oprsz)
 {
-    intptr_t oprsz = simd_oprsz(desc);
     intptr_t i;
 
     for (i = 0; i < oprsz; i += sizeof(int8_t)) {
@@ -1082,12 +1081,10 @@ void HELPER(gvec_ssadd8)(void *d, void *a, void *b, uint32_t desc)
         }
         *(int8_t *)(d + i) = r;
     }
-    clear_high(d, oprsz, desc);
 }
 
-void HELPER(gvec_ssadd16)(void *d, void *a, void *b, uint32_t desc)
+static void gvec_ssadd16_int(void *d, void *a, void *b, intptr_t oprsz)
 {
-    intptr_t oprsz = simd_oprsz(desc);
     intptr_t i;
 
     for (i = 0; i < oprsz; i += sizeof(int16_t)) {
@@ -1099,7 +1096,6 @@ void HELPER(gvec_ssadd16)(void *d, void *a, void *b, uint32_t desc)
         }
         *(int16_t *)(d + i) = r;
     }
-    clear_high(d, oprsz, desc);
 }
 
 void HELPER(gvec_ssadd32)(void *d, void *a, void *b, uint32_t desc)
@@ -1136,9 +1132,8 @@ void HELPER(gvec_ssadd64)(void *d, void *a, void *b, uint32_t desc)
     clear_high(d, oprsz, desc);
 }
 
-void HELPER(gvec_sssub8)(void *d, void *a, void *b, uint32_t desc)
+static void gvec_sssub8_int(void *d, void *a, void *b, intptr_t oprsz)
 {
-    intptr_t oprsz = simd_oprsz(desc);
     intptr_t i;
 
     for (i = 0; i < oprsz; i += sizeof(uint8_t)) {
@@ -1150,12 +1145,10 @@ void HELPER(gvec_sssub8)(void *d, void *a, void *b, uint32_t desc)
         }
         *(uint8_t *)(d + i) = r;
     }
-    clear_high(d, oprsz, desc);
 }
 
-void HELPER(gvec_sssub16)(void *d, void *a, void *b, uint32_t desc)
+static void gvec_sssub16_int(void *d, void *a, void *b, intptr_t oprsz)
 {
-    intptr_t oprsz = simd_oprsz(desc);
     intptr_t i;
 
     for (i = 0; i < oprsz; i += sizeof(int16_t)) {
@@ -1167,7 +1160,6 @@ void HELPER(gvec_sssub16)(void *d, void *a, void *b, uint32_t desc)
         }
         *(int16_t *)(d + i) = r;
     }
-    clear_high(d, oprsz, desc);
 }
 
 void HELPER(gvec_sssub32)(void *d, void *a, void *b, uint32_t desc)
@@ -1204,9 +1196,8 @@ void HELPER(gvec_sssub64)(void *d, void *a, void *b, uint32_t desc)
     clear_high(d, oprsz, desc);
 }
 
-void HELPER(gvec_usadd8)(void *d, void *a, void *b, uint32_t desc)
+static void gvec_usadd8_int(void *d, void *a, void *b, intptr_t oprsz)
 {
-    intptr_t oprsz = simd_oprsz(desc);
     intptr_t i;
 
     for (i = 0; i < oprsz; i += sizeof(uint8_t)) {
@@ -1216,12 +1207,10 @@ void HELPER(gvec_usadd8)(void *d, void *a, void *b, uint32_t desc)
         }
         *(uint8_t *)(d + i) = r;
     }
-    clear_high(d, oprsz, desc);
 }
 
-void HELPER(gvec_usadd16)(void *d, void *a, void *b, uint32_t desc)
+static void gvec_usadd16_int(void *d, void *a, void *b, intptr_t oprsz)
 {
-    intptr_t oprsz = simd_oprsz(desc);
     intptr_t i;
 
     for (i = 0; i < oprsz; i += sizeof(uint16_t)) {
@@ -1231,7 +1220,6 @@ void HELPER(gvec_usadd16)(void *d, void *a, void *b, uint32_t desc)
         }
         *(uint16_t *)(d + i) = r;
     }
-    clear_high(d, oprsz, desc);
 }
 
 void HELPER(gvec_usadd32)(void *d, void *a, void *b, uint32_t desc)
@@ -1268,9 +1256,8 @@ void HELPER(gvec_usadd64)(void *d, void *a, void *b, uint32_t desc)
     clear_high(d, oprsz, desc);
 }
 
-void HELPER(gvec_ussub8)(void *d, void *a, void *b, uint32_t desc)
+static void gvec_ussub8_int(void *d, void *a, void *b, intptr_t oprsz)
 {
-    intptr_t oprsz = simd_oprsz(desc);
     intptr_t i;
 
     for (i = 0; i < oprsz; i += sizeof(uint8_t)) {
@@ -1280,12 +1267,10 @@ void HELPER(gvec_ussub8)(void *d, void *a, void *b, uint32_t desc)
         }
         *(uint8_t *)(d + i) = r;
     }
-    clear_high(d, oprsz, desc);
 }
 
-void HELPER(gvec_ussub16)(void *d, void *a, void *b, uint32_t desc)
+static void gvec_ussub16_int(void *d, void *a, void *b, intptr_t oprsz)
 {
-    intptr_t oprsz = simd_oprsz(desc);
     intptr_t i;
 
     for (i = 0; i < oprsz; i += sizeof(uint16_t)) {
@@ -1295,7 +1280,6 @@ void HELPER(gvec_ussub16)(void *d, void *a, void *b, uint32_t desc)
         }
         *(uint16_t *)(d + i) = r;
     }
-    clear_high(d, oprsz, desc);
 }
 
 void HELPER(gvec_ussub32)(void *d, void *a, void *b, uint32_t desc)
@@ -1332,6 +1316,172 @@ void HELPER(gvec_ussub64)(void *d, void *a, void *b, uint32_t desc)
     clear_high(d, oprsz, desc);
 }
 
+/*
+ * The 8 and 16-bit saturating operations do not auto-vectorize, but
+ * map directly onto host instructions.  Here oprsz is either 8 or a
+ * multiple of 16; the 8 byte case always uses the integer fallback.
+ */
+typedef void gvec_sat_fn(void *d, void *a, void *b, intptr_t oprsz);
+
+typedef struct GVecSatAccel {
+    gvec_sat_fn *ssadd8, *ssadd16, *sssub8, *sssub16;
+    gvec_sat_fn *usadd8, *usadd16, *ussub8, *ussub16;
+} GVecSatAccel;
+
+#if !defined(__SSE2__) && !defined(__aarch64__)
+static const GVecSatAccel gvec_sat_int = {
+    gvec_ssadd8_int, gvec_ssadd16_int, gvec_sssub8_int, gvec_sssub16_int,
+    gvec_usadd8_int, gvec_usadd16_int, gvec_ussub8_int, gvec_ussub16_int,
+};
+#endif
+
+#if defined(CONFIG_AVX2_OPT) || defined(__SSE2__)
+#include <immintrin.h>
+
+#define DO_SAT_SSE2(NAME, FN)                                           \
+static void __attribute__((target("sse2")))                             \
+gvec_##NAME##_sse2(void *d, void *a, void *b, intptr_t oprsz)           \
+{                                                                       \
+    for (intptr_t i = 0; i < oprsz; i += 16) {                          \
+        __m128i ai = _mm_loadu_si128(a + i);                            \
+        __m128i bi = _mm_loadu_si128(b + i);                            \
+        _mm_storeu_si128(d + i, FN(ai, bi));                            \
+    }                                                                   \
+}
+
+DO_SAT_SSE2(ssadd8, _mm_adds_epi8)
+DO_SAT_SSE2(ssadd16, _mm_adds_epi16)
+DO_SAT_SSE2(sssub8, _mm_subs_epi8)
+DO_SAT_SSE2(sssub16, _mm_subs_epi16)
+DO_SAT_SSE2(usadd8, _mm_adds_epu8)
+DO_SAT_SSE2(usadd16, _mm_adds_epu16)
+DO_SAT_SSE2(ussub8, _mm_subs_epu8)
+DO_SAT_SSE2(ussub16, _mm_subs_epu16)
+
+#undef DO_SAT_SSE2
+
+static const GVecSatAccel gvec_sat_sse2 = {
+    gvec_ssadd8_sse2, gvec_ssadd16_sse2, gvec_sssub8_sse2, gvec_sssub16_sse2,
+    gvec_usadd8_sse2, gvec_usadd16_sse2, gvec_ussub8_sse2, gvec_ussub16_sse2,
+};
+
+#ifdef CONFIG_AVX2_OPT
+#include "host/cpuinfo.h"
+
+#define DO_SAT_AVX2(NAME, FN)                                           \
+static void __attribute__((target("avx2")))                             \
+gvec_##NAME##_avx2(void *d, void *a, void *b, intptr_t oprsz)           \
+{                                                                       \
+    intptr_t i;                                                         \
+    for (i = 0; i + 32 <= oprsz; i += 32) {                             \
+        __m256i ai = _mm256_loadu_si256(a + i);                         \
+        __m256i bi = _mm256_loadu_si256(b + i);                         \
+        _mm256_storeu_si256(d + i, _mm256_##FN(ai, bi));                \
+    }                                                                   \
+    if (i < oprsz) {                                                    \
+        __m128i ai = _mm_loadu_si128(a + i);                            \
+        __m128i bi = _mm_loadu_si128(b + i);                            \
+        _mm_storeu_si128(d + i, _mm_##FN(ai, bi));                      \
+    }                                                                   \
+}
+
+DO_SAT_AVX2(ssadd8, adds_epi8)
+DO_SAT_AVX2(ssadd16, adds_epi16)
+DO_SAT_AVX2(sssub8, subs_epi8)
+DO_SAT_AVX2(sssub16, subs_epi16)
+DO_SAT_AVX2(usadd8, adds_epu8)
+DO_SAT_AVX2(usadd16, adds_epu16)
+DO_SAT_AVX2(ussub8, subs_epu8)
+DO_SAT_AVX2(ussub16, subs_epu16)
+
+#undef DO_SAT_AVX2
+
+static const GVecSatAccel gvec_sat_avx2 = {
+    gvec_ssadd8_avx2, gvec_ssadd16_avx2, gvec_sssub8_avx2, gvec_sssub16_avx2,
+    gvec_usadd8_avx2, gvec_usadd16_avx2, gvec_ussub8_avx2, gvec_ussub16_avx2,
+};
+#endif /* CONFIG_AVX2_OPT */
+
+/*
+ * As for util/bufferiszero.c, SSE2 may not be enabled on the compiler
+ * command-line when CONFIG_AVX2_OPT is, so select it at runtime too.
+ */
+#ifdef __SSE2__
+static const GVecSatAccel *gvec_sat_accel = &gvec_sat_sse2;
+#else
+static const GVecSatAccel *gvec_sat_accel = &gvec_sat_int;
+#endif
+
+#ifdef CONFIG_AVX2_OPT
+static void __attribute__((constructor)) init_gvec_sat_accel(void)
+{
+    unsigned info = cpuinfo_init();
+
+    if (info & CPUINFO_AVX2) {
+        gvec_sat_accel = &gvec_sat_avx2;
+    } else if (info & CPUINFO_SSE2) {
+        gvec_sat_accel = &gvec_sat_sse2;
+    }
+}
+#endif /* CONFIG_AVX2_OPT */
+
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+
+#define DO_SAT_NEON(NAME, FN, T)                                        \
+static void gvec_##NAME##_neon(void *d, void *a, void *b, intptr_t oprsz) \
+{                                                                       \
+    for (intptr_t i = 0; i < oprsz; i += 16) {                          \
+        vst1q_##T(d + i, FN##_##T(vld1q_##T(a + i), vld1q_##T(b + i))); \
+    }                                                                   \
+}
+
+DO_SAT_NEON(ssadd8, vqaddq, s8)
+DO_SAT_NEON(ssadd16, vqaddq, s16)
+DO_SAT_NEON(sssub8, vqsubq, s8)
+DO_SAT_NEON(sssub16, vqsubq, s16)
+DO_SAT_NEON(usadd8, vqaddq, u8)
+DO_SAT_NEON(usadd16, vqaddq, u16)
+DO_SAT_NEON(ussub8, vqsubq, u8)
+DO_SAT_NEON(ussub16, vqsubq, u16)
+
+#undef DO_SAT_NEON
+
+/* Advanced SIMD is mandatory for AArch64, so no runtime selection. */
+static const GVecSatAccel gvec_sat_neon = {
+    gvec_ssadd8_neon, gvec_ssadd16_neon, gvec_sssub8_neon, gvec_sssub16_neon,
+    gvec_usadd8_neon, gvec_usadd16_neon, gvec_ussub8_neon, gvec_ussub16_neon,
+};
+
+static const GVecSatAccel *gvec_sat_accel = &gvec_sat_neon;
+
+#else
+static const GVecSatAccel *gvec_sat_accel = &gvec_sat_int;
+#endif
+
+#define DO_SAT(NAME)                                                    \
+void HELPER(gvec_##NAME)(void *d, void *a, void *b, uint32_t desc)      \
+{                                                                       \
+    intptr_t oprsz = simd_oprsz(desc);                                  \
+    if (likely(oprsz >= 16)) {                                          \
+        gvec_sat_accel->NAME(d, a, b, oprsz);                           \
+    } else {                                                            \
+        gvec_##NAME##_int(d, a, b, oprsz);                              \
+    }                                                                   \
+    clear_high(d, oprsz, desc);                                         \
+}
+
+DO_SAT(ssadd8)
+DO_SAT(ssadd16)
+DO_SAT(sssub8)
+DO_SAT(sssub16)
+DO_SAT(usadd8)
+DO_SAT(usadd16)
+DO_SAT(ussub8)
+DO_SAT(ussub16)
+
+#undef DO_SAT
+
 void HELPER(gvec_smin8)(void *d, void *a, void *b, uint32_t desc)
 {
     intptr_t oprsz = simd_oprsz(desc);
@@ -284,6 +284,34 @@ static int setjmp_gen_code(CPUArchState *env, TranslationBlock *tb,
     return tcg_gen_code(tcg_ctx, tb, pc);
 }
 
+static bool tb_gen_code_cmp(const void *p, const void *d)
+{
+    const TranslationBlock *tb = p;
+    const TranslationBlock *desc = d;
+
+    return (tb_cflags(tb) & CF_PCREL || tb->pc == desc->pc) &&
+           tb_page_addr0(tb) == tb_page_addr0(desc) &&
+           tb_page_addr1(tb) == -1 &&
+           tb->cs_base == desc->cs_base &&
+           tb->flags == desc->flags &&
+           tb_cflags(tb) == tb_cflags(desc);
+}
+
+/*
+ * Look for a TB matching the one about to be translated, which another
+ * thread may have published while we waited for the page lock.  Only
+ * single-page TBs are considered, so that no guest page table walk (and
+ * hence no exception) can happen with the page lock held.
+ */
+static TranslationBlock *tb_gen_code_lookup(TranslationBlock *tb, vaddr pc)
+{
+    uint32_t h = tb_hash_func(tb_page_addr0(tb),
+                              (tb->cflags & CF_PCREL ? 0 : pc),
+                              tb->flags, tb->cs_base, tb->cflags);
+
+    return qht_lookup_custom(&tb_ctx.htable, tb, h, tb_gen_code_cmp);
+}
+
 /* Called with mmap_lock held for user mode emulation.  */
 TranslationBlock *tb_gen_code(CPUState *cpu,
                               vaddr pc, uint64_t cs_base,
@@ -335,8 +363,22 @@ TranslationBlock *tb_gen_code(CPUState *cpu,
     tb->cflags = cflags;
     tb_set_page_addr0(tb, phys_pc);
     tb_set_page_addr1(tb, -1);
-    if (phys_pc != -1) {
-        tb_lock_page0(phys_pc);
+    if (phys_pc != -1 && tb_lock_page0(phys_pc)) {
+        /*
+         * Other vCPUs tend to miss on the same cold code at the same time.
+         * If the page lock was contended, the holder may just have
+         * translated this very block: use it rather than translating it
+         * again only to discard the result in tb_link_page.
+         */
+        existing_tb = tb_gen_code_lookup(tb, pc);
+        if (existing_tb) {
+            uintptr_t orig_aligned = (uintptr_t)gen_code_buf;
+
+            tb_unlock_pages(tb);
+            orig_aligned -= ROUND_UP(sizeof(*tb), qemu_icache_linesize);
+            qatomic_set(&tcg_ctx->code_gen_ptr, (void *)orig_aligned);
+            return existing_tb;
+        }
     }
 
     tcg_ctx->gen_tb = tb;
@@ -672,4 +714,7 @@ void tcg_flush_jmp_cache(CPUState *cpu)
     for (int i = 0; i < TB_JMP_CACHE_SIZE; i++) {
         qatomic_set(&jc->array[i].tb, NULL);
     }
+    for (int i = 0; i < TB_JMP_VICTIM_SIZE; i++) {
+        qatomic_set(&jc->victim[i].tb, NULL);
+    }
 }
@@ -283,6 +283,20 @@ SRST
     Show dynamic compiler opcode counters
 ERST
 
+#if defined(CONFIG_TCG)
+    {
+        .name       = "jit-profile",
+        .args_type  = "",
+        .params     = "",
+        .help       = "show the hottest sampled translation blocks",
+    },
+#endif
+
+SRST
+  ``info jit-profile``
+    Show the hottest guest code found by translation block sampling.
+ERST
+
     {
         .name       = "sync-profile",
         .args_type  = "mean:-m,no_coalesce:-n,max:i?",
@@ -1247,6 +1247,30 @@ ssize_t rom_add_option(const char *file, int32_t bootindex)
     return rom_add_file(file, "genroms", 0, bootindex, true, NULL, NULL);
 }
 
+/*
+ * Return true if guest RAM already holds exactly what @rom would write,
+ * e.g. on a guest reboot.  Skipping the write then keeps the code that
+ * was translated from the image valid.
+ */
+static bool rom_is_loaded(Rom *rom)
+{
+    MemoryRegion *mr;
+    hwaddr xlat, len = rom->romsize;
+    uint8_t *host;
+
+    RCU_READ_LOCK_GUARD();
+    mr = address_space_translate(rom->as, rom->addr, &xlat, &len, false,
+                                 MEMTXATTRS_UNSPECIFIED);
+    if (!memory_region_is_ram(mr) || memory_region_is_ram_device(mr) ||
+        len < rom->romsize) {
+        return false;
+    }
+    host = memory_region_get_ram_ptr(mr) + xlat;
+    return memcmp(host, rom->data, rom->datasize) == 0 &&
+           buffer_is_zero(host + rom->datasize,
+                          rom->romsize - rom->datasize);
+}
+
 static void rom_reset(void *unused)
 {
     Rom *rom;
@@ -1278,7 +1302,7 @@ static void rom_reset(void *unused)
             void *host = memory_region_get_ram_ptr(rom->mr);
             memcpy(host, rom->data, rom->datasize);
             memset(host + rom->datasize, 0, rom->romsize - rom->datasize);
-        } else {
+        } else if (!rom_is_loaded(rom)) {
             address_space_write_rom(rom->as, rom->addr, MEMTXATTRS_UNSPECIFIED,
                                     rom->data, rom->datasize);
             address_space_set(rom->as, rom->addr + rom->datasize, 0,
@@ -106,18 +106,33 @@ static void riscv_aclint_mtimer_write_timecmp(RISCVAclintMTimerState *mtimer,
         next = MIN(next, INT64_MAX);
     }
 
+    /*
+     * If the timer is already armed to fire no later than the new deadline,
+     * leave it alone and let the callback re-arm it for the remainder.
+     * Guests move the deadline forward on every tick, and this avoids a
+     * timer list update for each of those writes.
+     */
+    if (timer_expire_time_ns(mtimer->timers[hartid]) <= next) {
+        return;
+    }
+
     timer_mod(mtimer->timers[hartid], next);
 }
 
 /*
  * Callback used when the timer set using timer_mod expires.
- * Should raise the timer interrupt line
+ * Raises the timer interrupt line, or re-arms the timer if mtimecmp
+ * was moved further into the future since it was armed.
  */
 static void riscv_aclint_mtimer_cb(void *opaque)
 {
     riscv_aclint_mtimer_callback *state = opaque;
+    RISCVAclintMTimerState *mtimer = state->s;
+    uint32_t hartid = mtimer->hartid_base + state->num;
 
-    qemu_irq_raise(state->s->timer_irqs[state->num]);
+    riscv_aclint_mtimer_write_timecmp(mtimer,
+                                      RISCV_CPU(cpu_by_arch_id(hartid)),
+                                      hartid, mtimer->timecmp[state->num]);
 }
 
 /* CPU read MTIMER register */
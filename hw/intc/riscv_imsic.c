@@ -73,6 +73,29 @@ static void riscv_imsic_update(RISCVIMSICState *imsic, uint32_t page)
     }
 }
 
+/*
+ * Setting a pending bit can only ever raise the external interrupt, and
+ * only if the identity is enabled and below the threshold.  Check that
+ * directly instead of rescanning the whole interrupt file with
+ * riscv_imsic_update() for every incoming MSI.
+ */
+static void riscv_imsic_deliver(RISCVIMSICState *imsic, uint32_t page,
+                                uint32_t id)
+{
+    uint32_t *eistate = &imsic->eistate[(page * imsic->num_irqs) + id];
+    uint32_t threshold = imsic->eithreshold[page];
+
+    if (*eistate & IMSIC_EISTATE_PENDING) {
+        return;
+    }
+    *eistate |= IMSIC_EISTATE_PENDING;
+
+    if (imsic->eidelivery[page] && (*eistate & IMSIC_EISTATE_ENABLED) &&
+        (!threshold || id < threshold)) {
+        qemu_irq_raise(imsic->external_irqs[page]);
+    }
+}
+
 static int riscv_imsic_eidelivery_rmw(RISCVIMSICState *imsic, uint32_t page,
                                       target_ulong *val,
                                       target_ulong new_val,
@@ -302,14 +325,10 @@ static void riscv_imsic_write(void *opaque, hwaddr addr, uint64_t value,
     page = addr >> IMSIC_MMIO_PAGE_SHIFT;
     if ((addr & (IMSIC_MMIO_PAGE_SZ - 1)) == IMSIC_MMIO_PAGE_LE) {
         if (value && (value < imsic->num_irqs)) {
-            imsic->eistate[(page * imsic->num_irqs) + value] |=
-                                                    IMSIC_EISTATE_PENDING;
+            riscv_imsic_deliver(imsic, page, value);
         }
     }
 
-    /* Update CPU external interrupt status */
-    riscv_imsic_update(imsic, page);
-
     return;
 
 err:
@@ -76,61 +76,64 @@ static uint32_t sifive_plic_claimed(SiFivePLICState *plic, uint32_t addrid)
 {
     uint32_t max_irq = 0;
     uint32_t max_prio = plic->target_priority[addrid];
-    int i, j;
-    int num_irq_in_word = 32;
+    int i;
 
     for (i = 0; i < plic->bitfield_words; i++) {
         uint32_t pending_enabled_not_claimed =
                         (plic->pending[i] & ~plic->claimed[i]) &
                             plic->enable[addrid * plic->bitfield_words + i];
 
-        if (!pending_enabled_not_claimed) {
-            continue;
-        }
-
-        if (i == (plic->bitfield_words - 1)) {
-            /*
-             * If plic->num_sources is not multiple of 32, num-of-irq in last
-             * word is not 32. Compute the num-of-irq of last word to avoid
-             * out-of-bound access of source_priority array.
-             */
-            num_irq_in_word = plic->num_sources - ((plic->bitfield_words - 1) << 5);
-        }
-
-        for (j = 0; j < num_irq_in_word; j++) {
-            int irq = (i << 5) + j;
+        /*
+         * Only visit the sources that are actually pending.  Pending bits
+         * are never set beyond num_sources, so there is no need to bound
+         * the last word separately.
+         */
+        while (pending_enabled_not_claimed) {
+            int irq = (i << 5) + ctz32(pending_enabled_not_claimed);
             uint32_t prio = plic->source_priority[irq];
-            int enabled = pending_enabled_not_claimed & (1 << j);
 
-            if (enabled && prio > max_prio) {
+            if (prio > max_prio) {
                 max_irq = irq;
                 max_prio = prio;
             }
+            pending_enabled_not_claimed &= pending_enabled_not_claimed - 1;
         }
     }
 
     return max_irq;
 }
 
-static void sifive_plic_update(SiFivePLICState *plic)
+static void sifive_plic_update_addr(SiFivePLICState *plic, uint32_t addrid)
+{
+    uint32_t hartid = plic->addr_config[addrid].hartid;
+    PLICMode mode = plic->addr_config[addrid].mode;
+    bool level = !!sifive_plic_claimed(plic, addrid);
+
+    switch (mode) {
+    case PLICMode_M:
+        qemu_set_irq(plic->m_external_irqs[hartid - plic->hartid_base], level);
+        break;
+    case PLICMode_S:
+        qemu_set_irq(plic->s_external_irqs[hartid - plic->hartid_base], level);
+        break;
+    default:
+        break;
+    }
+}
+
+/*
+ * Raise irq on harts where this irq is enabled.  A change to the state of
+ * a single source cannot affect any other context, so leave those alone.
+ */
+static void sifive_plic_update_irq(SiFivePLICState *plic, uint32_t irq)
 {
+    uint32_t word = irq >> 5;
+    uint32_t mask = 1 << (irq & 31);
     int addrid;
 
-    /* raise irq on harts where this irq is enabled */
     for (addrid = 0; addrid < plic->num_addrs; addrid++) {
-        uint32_t hartid = plic->addr_config[addrid].hartid;
-        PLICMode mode = plic->addr_config[addrid].mode;
-        bool level = !!sifive_plic_claimed(plic, addrid);
-
-        switch (mode) {
-        case PLICMode_M:
-            qemu_set_irq(plic->m_external_irqs[hartid - plic->hartid_base], level);
-            break;
-        case PLICMode_S:
-            qemu_set_irq(plic->s_external_irqs[hartid - plic->hartid_base], level);
-            break;
-        default:
-            break;
+        if (plic->enable[addrid * plic->bitfield_words + word] & mask) {
+            sifive_plic_update_addr(plic, addrid);
         }
     }
 }
@@ -169,9 +172,11 @@ static uint64_t sifive_plic_read(void *opaque, hwaddr addr, unsigned size)
             if (max_irq) {
                 sifive_plic_set_pending(plic, max_irq, false);
                 sifive_plic_set_claimed(plic, max_irq, true);
+                sifive_plic_update_irq(plic, max_irq);
+            } else {
+                sifive_plic_update_addr(plic, addrid);
             }
 
-            sifive_plic_update(plic);
             return max_irq;
         }
     }
@@ -197,10 +202,10 @@ static void sifive_plic_write(void *opaque, hwaddr addr, uint64_t value,
              * out the access to unsupported priority bits.
              */
             plic->source_priority[irq] = value % (plic->num_priorities + 1);
-            sifive_plic_update(plic);
+            sifive_plic_update_irq(plic, irq);
         } else if (value <= plic->num_priorities) {
             plic->source_priority[irq] = value;
-            sifive_plic_update(plic);
+            sifive_plic_update_irq(plic, irq);
         }
     } else if (addr_between(addr, plic->pending_base,
                             (plic->num_sources + 31) >> 3)) {
@@ -214,6 +219,7 @@ static void sifive_plic_write(void *opaque, hwaddr addr, uint64_t value,
 
         if (wordid < plic->bitfield_words) {
             plic->enable[addrid * plic->bitfield_words + wordid] = value;
+            sifive_plic_update_addr(plic, addrid);
         } else {
             qemu_log_mask(LOG_GUEST_ERROR,
                           "%s: Invalid enable write 0x%" HWADDR_PRIx "\n",
@@ -233,15 +239,15 @@ static void sifive_plic_write(void *opaque, hwaddr addr, uint64_t value,
                  */
                 plic->target_priority[addrid] = value %
                                                 (plic->num_priorities + 1);
-                sifive_plic_update(plic);
+                sifive_plic_update_addr(plic, addrid);
             } else if (value <= plic->num_priorities) {
                 plic->target_priority[addrid] = value;
-                sifive_plic_update(plic);
+                sifive_plic_update_addr(plic, addrid);
             }
         } else if (contextid == 4) {
             if (value < plic->num_sources) {
                 sifive_plic_set_claimed(plic, value, false);
-                sifive_plic_update(plic);
+                sifive_plic_update_irq(plic, value);
             }
         } else {
             qemu_log_mask(LOG_GUEST_ERROR,
@@ -350,7 +356,7 @@ static void sifive_plic_irq_request(void *opaque, int irq, int level)
     SiFivePLICState *s = opaque;
 
     sifive_plic_set_pending(s, irq, level > 0);
-    sifive_plic_update(s);
+    sifive_plic_update_irq(s, irq);
 }
 
 static void sifive_plic_realize(DeviceState *dev, Error **errp)
@@ -45,6 +45,7 @@
 #include "sysemu/arch_init.h"
 #include "sysemu/device_tree.h"
 #include "sysemu/sysemu.h"
+#include "sysemu/kvm.h"
 #include "exec/address-spaces.h"
 #include "elf.h"
 
@@ -73,12 +74,42 @@ static uint64_t load_kernel(const char *kernel_filename)
     return kernel_entry;
 }
 
+static void create_fdt_clint(SanctumState *s, const struct MemMapEntry *memmap)
+{
+    void *fdt = s->fdt;
+    int cpu;
+    uint32_t *cells;
+    char *nodename;
+
+    cells =  g_new0(uint32_t, s->soc.num_harts * 4);
+    for (cpu = 0; cpu < s->soc.num_harts; cpu++) {
+        nodename =
+            g_strdup_printf("/cpus/cpu@%d/interrupt-controller", cpu);
+        uint32_t intc_phandle = qemu_fdt_get_phandle(fdt, nodename);
+        cells[cpu * 4 + 0] = cpu_to_be32(intc_phandle);
+        cells[cpu * 4 + 1] = cpu_to_be32(IRQ_M_SOFT);
+        cells[cpu * 4 + 2] = cpu_to_be32(intc_phandle);
+        cells[cpu * 4 + 3] = cpu_to_be32(IRQ_M_TIMER);
+        g_free(nodename);
+    }
+    nodename = g_strdup_printf("/soc/clint@%lx",
+        (long)memmap[SANCTUM_CLINT].base);
+    qemu_fdt_add_subnode(fdt, nodename);
+    qemu_fdt_setprop_string(fdt, nodename, "compatible", "riscv,clint0");
+    qemu_fdt_setprop_cells(fdt, nodename, "reg",
+        0x0, memmap[SANCTUM_CLINT].base,
+        0x0, memmap[SANCTUM_CLINT].size);
+    qemu_fdt_setprop(fdt, nodename, "interrupts-extended",
+        cells, s->soc.num_harts * sizeof(uint32_t) * 4);
+    g_free(cells);
+    g_free(nodename);
+}
+
 static void create_fdt(SanctumState *s, const struct MemMapEntry *memmap,
     uint64_t mem_size, const char *cmdline)
 {
     void *fdt;
     int cpu;
-    uint32_t *cells;
     char *nodename;
     uint32_t phandle = 1;
 
@@ -144,28 +175,10 @@ static void create_fdt(SanctumState *s, const struct MemMapEntry *memmap,
         g_free(nodename);
     }
 
-    cells =  g_new0(uint32_t, s->soc.num_harts * 4);
-    for (cpu = 0; cpu < s->soc.num_harts; cpu++) {
-        nodename =
-            g_strdup_printf("/cpus/cpu@%d/interrupt-controller", cpu);
-        uint32_t intc_phandle = qemu_fdt_get_phandle(fdt, nodename);
-        cells[cpu * 4 + 0] = cpu_to_be32(intc_phandle);
-        cells[cpu * 4 + 1] = cpu_to_be32(IRQ_M_SOFT);
-        cells[cpu * 4 + 2] = cpu_to_be32(intc_phandle);
-        cells[cpu * 4 + 3] = cpu_to_be32(IRQ_M_TIMER);
-        g_free(nodename);
+    /* Under KVM the host provides the timer and IPIs through SBI */
+    if (!kvm_enabled()) {
+        create_fdt_clint(s, memmap);
     }
-    nodename = g_strdup_printf("/soc/clint@%lx",
-        (long)memmap[SANCTUM_CLINT].base);
-    qemu_fdt_add_subnode(fdt, nodename);
-    qemu_fdt_setprop_string(fdt, nodename, "compatible", "riscv,clint0");
-    qemu_fdt_setprop_cells(fdt, nodename, "reg",
-        0x0, memmap[SANCTUM_CLINT].base,
-        0x0, memmap[SANCTUM_CLINT].size);
-    qemu_fdt_setprop(fdt, nodename, "interrupts-extended",
-        cells, s->soc.num_harts * sizeof(uint32_t) * 4);
-    g_free(cells);
-    g_free(nodename);
 
     if (cmdline) {
         qemu_fdt_add_subnode(fdt, "/chosen");
@@ -187,12 +200,30 @@ static void sanctum_board_init(MachineState *machine)
     int base_hartid = 0;
     int hart_count = machine->smp.cpus;
     bool htif_custom_base = false;
+    uint64_t kernel_entry = 0;
 
     /* Ensure the requested configuration is legal for Sanctum */
     assert(TARGET_RISCV64);
     assert(PGSHIFT == 12);
     assert (machine->ram_size == 0x80000000); // Due to hacks on hacks on hack emulator is only defined for a machine with 2GB DRAM and 64 "regions" for enclave isolation.
 
+    /*
+     * The security monitor and the Sanctum CSRs live in M-mode, which a
+     * KVM guest never runs in.  Only a supervisor kernel can be booted
+     * directly, and enclaves are unavailable.
+     */
+    if (kvm_enabled()) {
+        if (machine->firmware) {
+            error_report("Sanctum firmware is not supported in "
+                         "combination with KVM.");
+            exit(1);
+        }
+        if (!machine->kernel_filename) {
+            error_report("Sanctum requires -kernel in combination with KVM.");
+            exit(1);
+        }
+    }
+
     /* Initialize SOC */
     object_initialize_child(OBJECT(machine), "soc", &s->soc,
                             TYPE_RISCV_HART_ARRAY);
@@ -227,7 +258,17 @@ static void sanctum_board_init(MachineState *machine)
                                 llc_controller); 
 
     if (machine->kernel_filename) {
-        load_kernel(machine->kernel_filename);
+        if (kvm_enabled()) {
+            /*
+             * The ELF entry of a Linux image is a virtual address; with
+             * the MMU off the kernel has to be entered at its load address.
+             */
+            kernel_entry = riscv_load_kernel(machine, &s->soc,
+                                             memmap[SANCTUM_DRAM].base,
+                                             false, htif_symbol_callback);
+        } else {
+            load_kernel(machine->kernel_filename);
+        }
     }
 
     /* reset vector */
@@ -284,6 +325,11 @@ static void sanctum_board_init(MachineState *machine)
                           memmap[SANCTUM_MROM].base + reset_vec_size,
                           &address_space_memory);
 
+    if (kvm_enabled()) {
+        riscv_setup_direct_kernel(kernel_entry,
+                                  memmap[SANCTUM_MROM].base + reset_vec_size);
+    }
+
     /* PUF */
     puf_create(memmap[SANCTUM_PUF].base, memmap[SANCTUM_PUF].size,
                0xDEADBEEFABADCAFEL);
@@ -302,12 +348,14 @@ static void sanctum_board_init(MachineState *machine)
     htif_mm_init(system_memory, serial_hd(0), memmap[SANCTUM_ELFLD].base, htif_custom_base);
 
     /* Core Local Interruptor (timer and IPI) */
-    riscv_aclint_swi_create(memmap[SANCTUM_CLINT].base, base_hartid, hart_count, false);
-    riscv_aclint_mtimer_create(
-        memmap[SANCTUM_CLINT].base + RISCV_ACLINT_SWI_SIZE,
-        RISCV_ACLINT_DEFAULT_MTIMER_SIZE, base_hartid, hart_count,
-        RISCV_ACLINT_DEFAULT_MTIMECMP, RISCV_ACLINT_DEFAULT_MTIME,
-        RISCV_ACLINT_DEFAULT_TIMEBASE_FREQ, false);
+    if (!kvm_enabled()) {
+        riscv_aclint_swi_create(memmap[SANCTUM_CLINT].base, base_hartid, hart_count, false);
+        riscv_aclint_mtimer_create(
+            memmap[SANCTUM_CLINT].base + RISCV_ACLINT_SWI_SIZE,
+            RISCV_ACLINT_DEFAULT_MTIMER_SIZE, base_hartid, hart_count,
+            RISCV_ACLINT_DEFAULT_MTIMECMP, RISCV_ACLINT_DEFAULT_MTIME,
+            RISCV_ACLINT_DEFAULT_TIMEBASE_FREQ, false);
+    }
 
 }
 
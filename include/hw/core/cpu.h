@@ -199,8 +199,14 @@ struct CPUClass {
  */
 #define NB_MMU_MODES 16
 
-/* Use a fully associative victim tlb of 8 entries. */
-#define CPU_VTLB_SIZE 8
+/*
+ * Use a 4-way set associative victim tlb of 64 entries.  The set is
+ * selected by a hash of the page number, see vtlb_set().
+ */
+#define CPU_VTLB_WAYS 4
+#define CPU_VTLB_SET_BITS 4
+#define CPU_VTLB_SETS (1 << CPU_VTLB_SET_BITS)
+#define CPU_VTLB_SIZE (CPU_VTLB_WAYS * CPU_VTLB_SETS)
 
 /*
  * The full TLB entry, which is not accessed by generated TCG code,
@@ -280,8 +286,8 @@ typedef struct CPUTLBDesc {
     /* maximum number of entries observed in the window */
     size_t window_max_entries;
     size_t n_used_entries;
-    /* The next index to use in the tlb victim table.  */
-    size_t vindex;
+    /* The next way to use in each set of the tlb victim table.  */
+    uint8_t vindex[CPU_VTLB_SETS];
     /* The tlb victim table, in two parts.  */
     CPUTLBEntry vtable[CPU_VTLB_SIZE];
     CPUTLBEntryFull vfulltlb[CPU_VTLB_SIZE];
@@ -482,6 +488,8 @@ struct CPUState {
     bool unplug;
     bool crash_occurred;
     bool exit_request;
+    /* TCG: record the next TB entered as a profiling sample */
+    bool tb_sample_request;
     int exclusive_context_count;
     uint32_t cflags_next_tb;
     /* updates protected by BQL */
@@ -1158,6 +1158,24 @@ void riscv_add_satp_mode_properties(Object *obj)
     }
 }
 
+/*
+ * Devices re-assert lines that are already asserted all the time: the PLIC
+ * re-evaluates every context that has a source enabled, and an ACLINT IPI
+ * may target a hart that has not taken the previous one yet.  Only mip
+ * feeds into the wakeup decision for these lines, so skip the update, and
+ * with it another kick of the vCPU thread, when the bit does not change.
+ */
+static void riscv_cpu_set_local_irq(CPURISCVState *env, int irq, int level)
+{
+    uint64_t mask = 1ULL << irq;
+
+    if (!!(env->mip & mask) == !!level) {
+        return;
+    }
+
+    riscv_cpu_update_mip(env, mask, BOOL_TO_MASK(level));
+}
+
 static void riscv_cpu_set_irq(void *opaque, int irq, int level)
 {
     RISCVCPU *cpu = RISCV_CPU(opaque);
@@ -1179,7 +1197,7 @@ static void riscv_cpu_set_irq(void *opaque, int irq, int level)
             if (kvm_enabled()) {
                 kvm_riscv_set_irq(cpu, irq, level);
             } else {
-                riscv_cpu_update_mip(env, 1 << irq, BOOL_TO_MASK(level));
+                riscv_cpu_set_local_irq(env, irq, level);
             }
              break;
         case IRQ_S_EXT:
@@ -1187,8 +1205,7 @@ static void riscv_cpu_set_irq(void *opaque, int irq, int level)
                 kvm_riscv_set_irq(cpu, irq, level);
             } else {
                 env->external_seip = level;
-                riscv_cpu_update_mip(env, 1 << irq,
-                                     BOOL_TO_MASK(level | env->software_seip));
+                riscv_cpu_set_local_irq(env, irq, level | env->software_seip);
             }
             break;
         default:
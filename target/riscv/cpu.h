@@ -418,6 +418,9 @@ struct CPUArchState {
     /* True if in debugger mode.  */
     bool debugger;
 
+    /* True if a superpage translation may be cached in the TLB. */
+    bool tlb_superpage;
+
     /*
      * CSRs for PointerMasking extension
      */
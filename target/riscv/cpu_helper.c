@@ -1177,6 +1177,10 @@ restart:
         }
     }
 
+    if (first_stage && !is_debug && (ptshift || napot_bits)) {
+        env->tlb_superpage = true;
+    }
+
     napot_mask = (1 << napot_bits) - 1;
     *physical = (((ppn & ~napot_mask) | (vpn & napot_mask) |
                   (vpn & (((target_ulong)1 << ptshift) - 1))
@@ -79,7 +79,6 @@ DEF_HELPER_FLAGS_2(froundnx_d, TCG_CALL_NO_RWG_SE, i64, env, i64)
 /* Bitmanip */
 DEF_HELPER_FLAGS_2(clmul, TCG_CALL_NO_RWG_SE, tl, tl, tl)
 DEF_HELPER_FLAGS_2(clmulr, TCG_CALL_NO_RWG_SE, tl, tl, tl)
-DEF_HELPER_FLAGS_1(brev8, TCG_CALL_NO_RWG_SE, tl, tl)
 DEF_HELPER_FLAGS_1(unzip, TCG_CALL_NO_RWG_SE, tl, tl)
 DEF_HELPER_FLAGS_1(zip, TCG_CALL_NO_RWG_SE, tl, tl)
 DEF_HELPER_FLAGS_2(xperm4, TCG_CALL_NO_RWG_SE, tl, tl, tl)
@@ -117,31 +116,32 @@ DEF_HELPER_FLAGS_2(fround_h, TCG_CALL_NO_RWG_SE, i64, env, i64)
 DEF_HELPER_FLAGS_2(froundnx_h, TCG_CALL_NO_RWG_SE, i64, env, i64)
 
 /* Cache-block operations */
-DEF_HELPER_2(cbo_clean_flush, void, env, tl)
-DEF_HELPER_2(cbo_inval, void, env, tl)
-DEF_HELPER_2(cbo_zero, void, env, tl)
+DEF_HELPER_FLAGS_2(cbo_clean_flush, TCG_CALL_NO_WG, void, env, tl)
+DEF_HELPER_FLAGS_2(cbo_inval, TCG_CALL_NO_WG, void, env, tl)
+DEF_HELPER_FLAGS_2(cbo_zero, TCG_CALL_NO_WG, void, env, tl)
 
 /* Special functions */
-DEF_HELPER_2(csrr, tl, env, int)
+DEF_HELPER_FLAGS_2(csrr, TCG_CALL_NO_WG, tl, env, int)
 DEF_HELPER_3(csrw, void, env, int, tl)
 DEF_HELPER_4(csrrw, tl, env, int, tl, tl)
-DEF_HELPER_2(csrr_i128, tl, env, int)
+DEF_HELPER_FLAGS_2(csrr_i128, TCG_CALL_NO_WG, tl, env, int)
 DEF_HELPER_4(csrw_i128, void, env, int, tl, tl)
 DEF_HELPER_6(csrrw_i128, tl, env, int, tl, tl, tl, tl)
 #ifndef CONFIG_USER_ONLY
 DEF_HELPER_1(sret, tl, env)
 DEF_HELPER_1(mret, tl, env)
 DEF_HELPER_1(wfi, void, env)
-DEF_HELPER_1(tlb_flush, void, env)
-DEF_HELPER_1(tlb_flush_all, void, env)
+DEF_HELPER_FLAGS_1(tlb_flush, TCG_CALL_NO_WG, void, env)
+DEF_HELPER_FLAGS_2(tlb_flush_page, TCG_CALL_NO_WG, void, env, tl)
+DEF_HELPER_FLAGS_1(tlb_flush_all, TCG_CALL_NO_WG, void, env)
 /* Native Debug */
-DEF_HELPER_1(itrigger_match, void, env)
+DEF_HELPER_FLAGS_1(itrigger_match, TCG_CALL_NO_WG, void, env)
 #endif
 
 /* Hypervisor functions */
 #ifndef CONFIG_USER_ONLY
-DEF_HELPER_1(hyp_tlb_flush, void, env)
-DEF_HELPER_1(hyp_gvma_tlb_flush, void, env)
+DEF_HELPER_FLAGS_1(hyp_tlb_flush, TCG_CALL_NO_WG, void, env)
+DEF_HELPER_FLAGS_1(hyp_gvma_tlb_flush, TCG_CALL_NO_WG, void, env)
 DEF_HELPER_FLAGS_2(hyp_hlv_bu, TCG_CALL_NO_WG, tl, env, tl)
 DEF_HELPER_FLAGS_2(hyp_hlv_hu, TCG_CALL_NO_WG, tl, env, tl)
 DEF_HELPER_FLAGS_2(hyp_hlv_wu, TCG_CALL_NO_WG, tl, env, tl)
@@ -1148,10 +1148,10 @@ DEF_HELPER_5(vsext_vf4_d, void, ptr, ptr, ptr, env, i32)
 DEF_HELPER_5(vsext_vf8_d, void, ptr, ptr, ptr, env, i32)
 
 /* 128-bit integer multiplication and division */
-DEF_HELPER_5(divu_i128, tl, env, tl, tl, tl, tl)
-DEF_HELPER_5(divs_i128, tl, env, tl, tl, tl, tl)
-DEF_HELPER_5(remu_i128, tl, env, tl, tl, tl, tl)
-DEF_HELPER_5(rems_i128, tl, env, tl, tl, tl, tl)
+DEF_HELPER_FLAGS_5(divu_i128, TCG_CALL_NO_RWG, tl, env, tl, tl, tl, tl)
+DEF_HELPER_FLAGS_5(divs_i128, TCG_CALL_NO_RWG, tl, env, tl, tl, tl, tl)
+DEF_HELPER_FLAGS_5(remu_i128, TCG_CALL_NO_RWG, tl, env, tl, tl, tl, tl)
+DEF_HELPER_FLAGS_5(rems_i128, TCG_CALL_NO_RWG, tl, env, tl, tl, tl, tl)
 
 /* Crypto functions */
 DEF_HELPER_FLAGS_3(aes32esmi, TCG_CALL_NO_RWG_SE, tl, tl, tl, tl)
@@ -1251,7 +1251,7 @@ DEF_HELPER_6(vandn_vx_h, void, ptr, ptr, tl, ptr, env, i32)
 DEF_HELPER_6(vandn_vx_w, void, ptr, ptr, tl, ptr, env, i32)
 DEF_HELPER_6(vandn_vx_d, void, ptr, ptr, tl, ptr, env, i32)
 
-DEF_HELPER_2(egs_check, void, i32, env)
+DEF_HELPER_FLAGS_2(egs_check, TCG_CALL_NO_WG, void, i32, env)
 
 DEF_HELPER_4(vaesef_vv, void, ptr, ptr, env, i32)
 DEF_HELPER_4(vaesef_vs, void, ptr, ptr, env, i32)
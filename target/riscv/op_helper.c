@@ -373,6 +373,12 @@ void helper_wfi(CPURISCVState *env)
     } else if (env->virt_enabled &&
                (prv_u || (prv_s && get_field(env->hstatus, HSTATUS_VTW)))) {
         riscv_raise_exception(env, RISCV_EXCP_VIRT_INSTRUCTION_FAULT, GETPC());
+    } else if (cpu_has_work(cs)) {
+        /*
+         * An enabled interrupt is already pending, so WFI completes right
+         * away.  Don't halt only to be woken up again by the main loop.
+         */
+        return;
     } else {
         cs->halted = 1;
         cs->exception_index = EXCP_HLT;
@@ -380,18 +386,39 @@ void helper_wfi(CPURISCVState *env)
     }
 }
 
-void helper_tlb_flush(CPURISCVState *env)
+static void check_tlb_flush(CPURISCVState *env, uintptr_t ra)
 {
-    CPUState *cs = env_cpu(env);
     if (!env->virt_enabled &&
         (env->priv == PRV_U ||
          (env->priv == PRV_S && get_field(env->mstatus, MSTATUS_TVM)))) {
-        riscv_raise_exception(env, RISCV_EXCP_ILLEGAL_INST, GETPC());
+        riscv_raise_exception(env, RISCV_EXCP_ILLEGAL_INST, ra);
     } else if (env->virt_enabled &&
                (env->priv == PRV_U || get_field(env->hstatus, HSTATUS_VTVM))) {
-        riscv_raise_exception(env, RISCV_EXCP_VIRT_INSTRUCTION_FAULT, GETPC());
+        riscv_raise_exception(env, RISCV_EXCP_VIRT_INSTRUCTION_FAULT, ra);
+    }
+}
+
+void helper_tlb_flush(CPURISCVState *env)
+{
+    check_tlb_flush(env, GETPC());
+    env->tlb_superpage = false;
+    tlb_flush(env_cpu(env));
+}
+
+/*
+ * sfence.vma with rs1 != x0 only needs to drop the translations for that
+ * page.  The TLB holds superpage translations as individual small pages,
+ * so once one may have been cached fall back to a full flush.  The ASID
+ * in rs2 is ignored, which flushes a superset of what is required.
+ */
+void helper_tlb_flush_page(CPURISCVState *env, target_ulong addr)
+{
+    check_tlb_flush(env, GETPC());
+    if (env->tlb_superpage) {
+        env->tlb_superpage = false;
+        tlb_flush(env_cpu(env));
     } else {
-        tlb_flush(cs);
+        tlb_flush_page(env_cpu(env), addr);
     }
 }
 
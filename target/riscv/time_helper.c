@@ -22,18 +22,26 @@
 #include "time_helper.h"
 #include "hw/intc/riscv_aclint.h"
 
+/*
+ * The timers may fire before the current deadline, see
+ * riscv_timer_write_timecmp(), so re-evaluate it rather than raising
+ * the interrupt unconditionally.
+ */
 static void riscv_vstimer_cb(void *opaque)
 {
     RISCVCPU *cpu = opaque;
     CPURISCVState *env = &cpu->env;
-    env->vstime_irq = 1;
-    riscv_cpu_update_mip(env, 0, BOOL_TO_MASK(1));
+
+    riscv_timer_write_timecmp(env, env->vstimer, env->vstimecmp,
+                              env->htimedelta, MIP_VSTIP);
 }
 
 static void riscv_stimer_cb(void *opaque)
 {
     RISCVCPU *cpu = opaque;
-    riscv_cpu_update_mip(&cpu->env, MIP_STIP, BOOL_TO_MASK(1));
+    CPURISCVState *env = &cpu->env;
+
+    riscv_timer_write_timecmp(env, env->stimer, env->stimecmp, 0, MIP_STIP);
 }
 
 /*
@@ -121,6 +129,15 @@ void riscv_timer_write_timecmp(CPURISCVState *env, QEMUTimer *timer,
         next = MIN(next, INT64_MAX);
     }
 
+    /*
+     * Linux rewrites stimecmp on every tick and hrtimer reprogram, usually
+     * to a later deadline.  If the timer is already armed to fire no later
+     * than that, leave it alone; the callback re-arms it for the remainder.
+     */
+    if (timer_expire_time_ns(timer) <= next) {
+        return;
+    }
+
     timer_mod(timer, next);
 }
 
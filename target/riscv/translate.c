@@ -571,6 +571,19 @@ static void gen_jal(DisasContext *ctx, int rd, target_ulong imm)
     gen_pc_plus_diff(succ_pc, ctx, ctx->cur_insn_len);
     gen_set_gpr(ctx, rd, succ_pc);
 
+    /*
+     * For a forward jump within the first page of the TB, simply continue
+     * translating at the target.  The TB then still covers every byte it
+     * was translated from (plus the skipped gap) for SMC invalidation, and
+     * the code on both sides of the jump is optimized as a single unit.
+     */
+    if ((target_long)imm > 0 &&
+        is_same_page(&ctx->base, ctx->base.pc_next + imm)) {
+        /* riscv_tr_translate_insn advances pc_next by cur_insn_len. */
+        ctx->base.pc_next += imm - ctx->cur_insn_len;
+        return;
+    }
+
     gen_goto_tb(ctx, 0, imm); /* must use this for safety */
     ctx->base.is_jmp = DISAS_NORETURN;
 }
@@ -691,6 +704,19 @@ static void gen_set_rm(DisasContext *ctx, int rm)
     gen_helper_set_rounding_mode(tcg_env, tcg_constant_i32(rm));
 }
 
+/*
+ * For conversions that are always exact the rounding mode is only
+ * checked, never used.  A valid static rm therefore need not be written
+ * to fp_status, which also keeps the dynamic mode installed for the
+ * surrounding arithmetic instead of forcing another helper call.
+ */
+static void gen_set_rm_exact(DisasContext *ctx, int rm)
+{
+    if (rm == RISCV_FRM_DYN || rm > RISCV_FRM_RMM) {
+        gen_set_rm(ctx, rm);
+    }
+}
+
 static void gen_set_rm_chkfrm(DisasContext *ctx, int rm)
 {
     if (ctx->frm == rm && ctx->frm_valid) {
@@ -24,6 +24,7 @@
 #include "cpu.h"
 #include "crypto/aes.h"
 #include "crypto/aes-round.h"
+#include "crypto/clmul.h"
 #include "crypto/sm4.h"
 #include "exec/memop.h"
 #include "exec/exec-all.h"
@@ -33,24 +34,12 @@
 
 static uint64_t clmul64(uint64_t y, uint64_t x)
 {
-    uint64_t result = 0;
-    for (int j = 63; j >= 0; j--) {
-        if ((y >> j) & 1) {
-            result ^= (x << j);
-        }
-    }
-    return result;
+    return int128_getlo(clmul_64(y, x));
 }
 
 static uint64_t clmulh64(uint64_t y, uint64_t x)
 {
-    uint64_t result = 0;
-    for (int j = 63; j >= 1; j--) {
-        if ((y >> j) & 1) {
-            result ^= (x >> (64 - j));
-        }
-    }
-    return result;
+    return int128_gethi(clmul_64(y, x));
 }
 
 RVVCALL(OPIVV2, vclmul_vv, OP_UUU_D, H8, H8, H8, clmul64)
@@ -338,6 +338,23 @@ static void tci_qemu_st(CPUArchState *env, uint64_t taddr, uint64_t val,
 # define CASE_64(x)
 #endif
 
+/*
+ * The most frequent opcodes are dispatched directly through a table of
+ * label addresses.  Each handler then ends in its own indirect jump,
+ * which the host predicts far better than the single shared jump of a
+ * switch.  Everything else falls back to the switch.
+ */
+#if TCG_TARGET_REG_BITS == 64
+# define DISPATCH_32_64(x) \
+        [glue(glue(INDEX_op_, x), _i64)] = &&glue(op_, x), \
+        [glue(glue(INDEX_op_, x), _i32)] = &&glue(op_, x),
+#else
+# define DISPATCH_32_64(x) \
+        [glue(glue(INDEX_op_, x), _i32)] = &&glue(op_, x),
+#endif
+#define DISPATCH(x) \
+        [glue(INDEX_op_, x)] = &&glue(op_, x),
+
 /* Interpret pseudo code in tb. */
 /*
  * Disable CFI checks.
@@ -347,6 +364,52 @@ static void tci_qemu_st(CPUArchState *env, uint64_t taddr, uint64_t val,
 uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
                                             const void *v_tb_ptr)
 {
+    static const void * const dispatch[1 << 8] = {
+        [0 ... (1 << 8) - 1] = &&do_switch,
+        DISPATCH(call)
+        DISPATCH(br)
+        DISPATCH(setcond_i32)
+        DISPATCH(brcond_i32)
+        DISPATCH_32_64(mov)
+        DISPATCH(tci_movi)
+        DISPATCH(tci_movl)
+        DISPATCH_32_64(ld8u)
+        DISPATCH_32_64(ld8s)
+        DISPATCH_32_64(ld16u)
+        DISPATCH_32_64(ld16s)
+        DISPATCH(ld_i32)
+        DISPATCH_32_64(st8)
+        DISPATCH_32_64(st16)
+        DISPATCH(st_i32)
+        DISPATCH_32_64(add)
+        DISPATCH_32_64(sub)
+        DISPATCH_32_64(and)
+        DISPATCH_32_64(or)
+        DISPATCH_32_64(xor)
+#if TCG_TARGET_REG_BITS == 64
+        DISPATCH(setcond_i64)
+        DISPATCH(brcond_i64)
+        DISPATCH(ld_i64)
+        DISPATCH(st_i64)
+        DISPATCH(ext32s_i64)
+        DISPATCH(ext32u_i64)
+        [INDEX_op_ld32u_i64] = &&op_ld_i32,
+        [INDEX_op_st32_i64] = &&op_st_i32,
+        [INDEX_op_ext_i32_i64] = &&op_ext32s_i64,
+        [INDEX_op_extu_i32_i64] = &&op_ext32u_i64,
+#endif
+        DISPATCH(exit_tb)
+        DISPATCH(goto_tb)
+        DISPATCH(goto_ptr)
+        DISPATCH(qemu_ld_a32_i32)
+        DISPATCH(qemu_ld_a64_i32)
+        DISPATCH(qemu_ld_a32_i64)
+        DISPATCH(qemu_ld_a64_i64)
+        DISPATCH(qemu_st_a32_i32)
+        DISPATCH(qemu_st_a64_i32)
+        DISPATCH(qemu_st_a32_i64)
+        DISPATCH(qemu_st_a64_i64)
+    };
     const uint32_t *tb_ptr = v_tb_ptr;
     tcg_target_ulong regs[TCG_TARGET_NB_REGS];
     uint64_t stack[(TCG_STATIC_CALL_ARGS_SIZE + TCG_STATIC_FRAME_SIZE)
@@ -372,9 +435,12 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
 
         insn = *tb_ptr++;
         opc = extract32(insn, 0, 8);
+        goto *dispatch[opc];
 
+    do_switch:
         switch (opc) {
         case INDEX_op_call:
+        op_call:
             {
                 void *call_slots[MAX_CALL_IARGS];
                 ffi_cif *cif;
@@ -428,13 +494,15 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             break;
 
         case INDEX_op_br:
+        op_br:
             tci_args_l(insn, tb_ptr, &ptr);
             tb_ptr = ptr;
             continue;
         case INDEX_op_setcond_i32:
+        op_setcond_i32:
             tci_args_rrrc(insn, &r0, &r1, &r2, &condition);
             regs[r0] = tci_compare32(regs[r1], regs[r2], condition);
-            break;
+            goto do_setcond;
         case INDEX_op_movcond_i32:
             tci_args_rrrrrc(insn, &r0, &r1, &r2, &r3, &r4, &condition);
             tmp32 = tci_compare32(regs[r1], regs[r2], condition);
@@ -446,27 +514,47 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             T1 = tci_uint64(regs[r2], regs[r1]);
             T2 = tci_uint64(regs[r4], regs[r3]);
             regs[r0] = tci_compare64(T1, T2, condition);
-            break;
+            goto do_setcond;
 #elif TCG_TARGET_REG_BITS == 64
         case INDEX_op_setcond_i64:
+        op_setcond_i64:
             tci_args_rrrc(insn, &r0, &r1, &r2, &condition);
             regs[r0] = tci_compare64(regs[r1], regs[r2], condition);
-            break;
+            goto do_setcond;
         case INDEX_op_movcond_i64:
             tci_args_rrrrrc(insn, &r0, &r1, &r2, &r3, &r4, &condition);
             tmp32 = tci_compare64(regs[r1], regs[r2], condition);
             regs[r0] = regs[tmp32 ? r3 : r4];
             break;
 #endif
+        do_setcond:
+            /*
+             * The backend expands brcond as setcond into TCG_REG_TMP,
+             * immediately followed by brcond of TCG_REG_TMP.  Take the
+             * branch here and save a dispatch.
+             */
+            if (r0 == TCG_REG_TMP) {
+                insn = *tb_ptr++;
+                tci_assert(extract32(insn, 0, 8) == INDEX_op_brcond_i32 ||
+                           extract32(insn, 0, 8) == INDEX_op_brcond_i64);
+                tci_args_rl(insn, tb_ptr, &r0, &ptr);
+                if (regs[r0]) {
+                    tb_ptr = ptr;
+                }
+            }
+            break;
         CASE_32_64(mov)
+        op_mov:
             tci_args_rr(insn, &r0, &r1);
             regs[r0] = regs[r1];
             break;
         case INDEX_op_tci_movi:
+        op_tci_movi:
             tci_args_ri(insn, &r0, &t1);
             regs[r0] = t1;
             break;
         case INDEX_op_tci_movl:
+        op_tci_movl:
             tci_args_rl(insn, tb_ptr, &r0, &ptr);
             regs[r0] = *(tcg_target_ulong *)ptr;
             break;
@@ -474,43 +562,51 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             /* Load/store operations (32 bit). */
 
         CASE_32_64(ld8u)
+        op_ld8u:
             tci_args_rrs(insn, &r0, &r1, &ofs);
             ptr = (void *)(regs[r1] + ofs);
             regs[r0] = *(uint8_t *)ptr;
             break;
         CASE_32_64(ld8s)
+        op_ld8s:
             tci_args_rrs(insn, &r0, &r1, &ofs);
             ptr = (void *)(regs[r1] + ofs);
             regs[r0] = *(int8_t *)ptr;
             break;
         CASE_32_64(ld16u)
+        op_ld16u:
             tci_args_rrs(insn, &r0, &r1, &ofs);
             ptr = (void *)(regs[r1] + ofs);
             regs[r0] = *(uint16_t *)ptr;
             break;
         CASE_32_64(ld16s)
+        op_ld16s:
             tci_args_rrs(insn, &r0, &r1, &ofs);
             ptr = (void *)(regs[r1] + ofs);
             regs[r0] = *(int16_t *)ptr;
             break;
         case INDEX_op_ld_i32:
         CASE_64(ld32u)
+        op_ld_i32:
             tci_args_rrs(insn, &r0, &r1, &ofs);
             ptr = (void *)(regs[r1] + ofs);
             regs[r0] = *(uint32_t *)ptr;
             break;
         CASE_32_64(st8)
+        op_st8:
             tci_args_rrs(insn, &r0, &r1, &ofs);
             ptr = (void *)(regs[r1] + ofs);
             *(uint8_t *)ptr = regs[r0];
             break;
         CASE_32_64(st16)
+        op_st16:
             tci_args_rrs(insn, &r0, &r1, &ofs);
             ptr = (void *)(regs[r1] + ofs);
             *(uint16_t *)ptr = regs[r0];
             break;
         case INDEX_op_st_i32:
         CASE_64(st32)
+        op_st_i32:
             tci_args_rrs(insn, &r0, &r1, &ofs);
             ptr = (void *)(regs[r1] + ofs);
             *(uint32_t *)ptr = regs[r0];
@@ -519,10 +615,12 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             /* Arithmetic operations (mixed 32/64 bit). */
 
         CASE_32_64(add)
+        op_add:
             tci_args_rrr(insn, &r0, &r1, &r2);
             regs[r0] = regs[r1] + regs[r2];
             break;
         CASE_32_64(sub)
+        op_sub:
             tci_args_rrr(insn, &r0, &r1, &r2);
             regs[r0] = regs[r1] - regs[r2];
             break;
@@ -531,14 +629,17 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             regs[r0] = regs[r1] * regs[r2];
             break;
         CASE_32_64(and)
+        op_and:
             tci_args_rrr(insn, &r0, &r1, &r2);
             regs[r0] = regs[r1] & regs[r2];
             break;
         CASE_32_64(or)
+        op_or:
             tci_args_rrr(insn, &r0, &r1, &r2);
             regs[r0] = regs[r1] | regs[r2];
             break;
         CASE_32_64(xor)
+        op_xor:
             tci_args_rrr(insn, &r0, &r1, &r2);
             regs[r0] = regs[r1] ^ regs[r2];
             break;
@@ -655,6 +756,7 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             break;
 #endif
         case INDEX_op_brcond_i32:
+        op_brcond_i32:
             tci_args_rl(insn, tb_ptr, &r0, &ptr);
             if ((uint32_t)regs[r0]) {
                 tb_ptr = ptr;
@@ -746,11 +848,13 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             regs[r0] = *(int32_t *)ptr;
             break;
         case INDEX_op_ld_i64:
+        op_ld_i64:
             tci_args_rrs(insn, &r0, &r1, &ofs);
             ptr = (void *)(regs[r1] + ofs);
             regs[r0] = *(uint64_t *)ptr;
             break;
         case INDEX_op_st_i64:
+        op_st_i64:
             tci_args_rrs(insn, &r0, &r1, &ofs);
             ptr = (void *)(regs[r1] + ofs);
             *(uint64_t *)ptr = regs[r0];
@@ -866,6 +970,7 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             break;
 #endif
         case INDEX_op_brcond_i64:
+        op_brcond_i64:
             tci_args_rl(insn, tb_ptr, &r0, &ptr);
             if (regs[r0]) {
                 tb_ptr = ptr;
@@ -873,11 +978,13 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             break;
         case INDEX_op_ext32s_i64:
         case INDEX_op_ext_i32_i64:
+        op_ext32s_i64:
             tci_args_rr(insn, &r0, &r1);
             regs[r0] = (int32_t)regs[r1];
             break;
         case INDEX_op_ext32u_i64:
         case INDEX_op_extu_i32_i64:
+        op_ext32u_i64:
             tci_args_rr(insn, &r0, &r1);
             regs[r0] = (uint32_t)regs[r1];
             break;
@@ -892,15 +999,18 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             /* QEMU specific operations. */
 
         case INDEX_op_exit_tb:
+        op_exit_tb:
             tci_args_l(insn, tb_ptr, &ptr);
             return (uintptr_t)ptr;
 
         case INDEX_op_goto_tb:
+        op_goto_tb:
             tci_args_l(insn, tb_ptr, &ptr);
             tb_ptr = *(void **)ptr;
             break;
 
         case INDEX_op_goto_ptr:
+        op_goto_ptr:
             tci_args_r(insn, &r0);
             ptr = (void *)regs[r0];
             if (!ptr) {
@@ -910,10 +1020,12 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             break;
 
         case INDEX_op_qemu_ld_a32_i32:
+        op_qemu_ld_a32_i32:
             tci_args_rrm(insn, &r0, &r1, &oi);
             taddr = (uint32_t)regs[r1];
             goto do_ld_i32;
         case INDEX_op_qemu_ld_a64_i32:
+        op_qemu_ld_a64_i32:
             if (TCG_TARGET_REG_BITS == 64) {
                 tci_args_rrm(insn, &r0, &r1, &oi);
                 taddr = regs[r1];
@@ -927,6 +1039,7 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             break;
 
         case INDEX_op_qemu_ld_a32_i64:
+        op_qemu_ld_a32_i64:
             if (TCG_TARGET_REG_BITS == 64) {
                 tci_args_rrm(insn, &r0, &r1, &oi);
                 taddr = (uint32_t)regs[r1];
@@ -937,6 +1050,7 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             }
             goto do_ld_i64;
         case INDEX_op_qemu_ld_a64_i64:
+        op_qemu_ld_a64_i64:
             if (TCG_TARGET_REG_BITS == 64) {
                 tci_args_rrm(insn, &r0, &r1, &oi);
                 taddr = regs[r1];
@@ -955,10 +1069,12 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             break;
 
         case INDEX_op_qemu_st_a32_i32:
+        op_qemu_st_a32_i32:
             tci_args_rrm(insn, &r0, &r1, &oi);
             taddr = (uint32_t)regs[r1];
             goto do_st_i32;
         case INDEX_op_qemu_st_a64_i32:
+        op_qemu_st_a64_i32:
             if (TCG_TARGET_REG_BITS == 64) {
                 tci_args_rrm(insn, &r0, &r1, &oi);
                 taddr = regs[r1];
@@ -972,6 +1088,7 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             break;
 
         case INDEX_op_qemu_st_a32_i64:
+        op_qemu_st_a32_i64:
             if (TCG_TARGET_REG_BITS == 64) {
                 tci_args_rrm(insn, &r0, &r1, &oi);
                 tmp64 = regs[r0];
@@ -984,6 +1101,7 @@ uintptr_t QEMU_DISABLE_CFI tcg_qemu_tb_exec(CPUArchState *env,
             }
             goto do_st_i64;
         case INDEX_op_qemu_st_a64_i64:
+        op_qemu_st_a64_i64:
             if (TCG_TARGET_REG_BITS == 64) {
                 tci_args_rrm(insn, &r0, &r1, &oi);
                 tmp64 = regs[r0];
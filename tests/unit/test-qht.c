@@ -114,6 +114,17 @@ static void check_n(size_t expected)
     qht_statistics_destroy(&stats);
 }
 
+static size_t get_resizes(void)
+{
+    struct qht_stats stats;
+    size_t ret;
+
+    qht_statistics_init(&ht, &stats);
+    ret = stats.resizes;
+    qht_statistics_destroy(&stats);
+    return ret;
+}
+
 static void iter_check(unsigned int count)
 {
     unsigned int curr = 0;
@@ -190,7 +201,11 @@ static void qht_do_test(unsigned int mode, size_t init_entries)
     iter_rm_mod(1);
 
     if (!(mode & QHT_MODE_AUTO_RESIZE)) {
-        qht_resize(&ht, init_entries * 4 + 4);
+        size_t resizes = get_resizes();
+
+        if (qht_resize(&ht, init_entries * 4 + 4)) {
+            g_assert_cmpuint(get_resizes(), ==, resizes + 1);
+        }
     }
 
     check_n(0);
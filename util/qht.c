@@ -471,6 +471,7 @@ void qht_init(struct qht *ht, qht_cmp_func_t cmp, size_t n_elems,
     g_assert(cmp);
     ht->cmp = cmp;
     ht->mode = mode;
+    ht->n_resizes = 0;
     qemu_mutex_init(&ht->lock);
     map = qht_map_create(n_buckets);
     qatomic_rcu_set(&ht->map, map);
@@ -946,6 +947,7 @@ static void qht_do_resize_reset(struct qht *ht, struct qht_map *new, bool reset)
     qht_map_debug__all_locked(new);
 
     qatomic_rcu_set(&ht->map, new);
+    qatomic_set(&ht->n_resizes, ht->n_resizes + 1);
     qht_map_unlock_buckets(old);
     call_rcu(old, qht_map_destroy, rcu);
 }
@@ -978,6 +980,7 @@ void qht_statistics_init(const struct qht *ht, struct qht_stats *stats)
 
     stats->used_head_buckets = 0;
     stats->entries = 0;
+    stats->resizes = qatomic_read(&ht->n_resizes);
     qdist_init(&stats->chain);
     qdist_init(&stats->occupancy);
     /* bail out if the qht has not yet been initialized */